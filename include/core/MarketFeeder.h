@@ -1,19 +1,21 @@
 #pragma once
 
 #include "core/Order.h"
-#include "utils/data_structures/ThreadSafeQueue.h"
+#include "core/OrderIngress.h"
 #include "utils/random/IRNG.h"
+#include "utils/time/IClock.h"
 
 #include <atomic>
 #include <chrono>
 #include <random>
 #include <thread>
 
-
 class MarketFeeder
 {
 public:
-  MarketFeeder(ThreadSafeQueue<Order> &queue, std::shared_ptr<IRNG> rng, uint16_t feeder_id = 0, uint32_t delay = 0);
+  // clock: order timestamps; feeders merged into one engine must share it
+  MarketFeeder(OrderLane &lane, std::shared_ptr<IRNG> rng, uint16_t feeder_id = 0, uint32_t delay = 0,
+               IClock &clock = default_clock());
   void start();
   void stop();
 
@@ -22,6 +24,7 @@ private:
   static constexpr int DELAY_MAX = 70;
   static constexpr int DELAY_JITTER = 5;
 
+  // Decimal price band, rounded onto the instrument's tick grid
   static constexpr double PRICE_MIN = 100.0;
   static constexpr double PRICE_MAX = 105.0;
 
@@ -36,7 +39,8 @@ private:
 
   std::atomic<bool> running_;
   std::thread worker_;
-  ThreadSafeQueue<Order> &queue_; // no moves just reference binding
+  OrderLane &lane_;               // this feeder's own SPSC lane (no moves just reference binding)
+  IClock &clock_;
   uint32_t delay_;                // Shift of the delay initial (DELAY_MIN-DELAY_MAX)
   uint16_t feeder_id_;
   uint64_t order_id_;
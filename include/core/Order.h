@@ -1,5 +1,8 @@
 #pragma once
 
+#include "core/Price.h"
+#include "utils/time/Timestamp.h"
+
 #include <cstdint>
 #include <type_traits>
 #include <assert.h>
@@ -26,6 +29,9 @@
 //   the struct remains exactly 64 bytes.
 // - Queue containers may not automatically preserve alignment; use
 //   cache-line-aware structures for multithreaded access.
+// - `poolPrev`/`poolNext` let a resting Order be its own intrusive list
+//   node inside the book (see engine/side/OrderPool.h): one cache line
+//   per resting order, no separate list node.
 
 struct ALIGNED(64) Order
 {
@@ -62,15 +68,17 @@ public:
         uint64_t customData;
     } extra;                 // 8
     uint64_t id;             // 8
-    double price;            // 8
+    Price price;             // 8 (ticks)
     uint64_t sequenceNumber; // 8
+    Timestamp timestamp;     // 8 (ns, see utils/time/Timestamp.h)
     uint32_t quantity;       // 4
-    uint32_t timestamp;      // 4
     uint8_t sideFlags;       // 1
     uint8_t controlFlags;    // 1
     uint8_t feederId;        // 1
     uint8_t reserved;        // 1 align to 4-byte boundary
-    uint8_t _padding[16];    // instead of 4
+    uint32_t poolPrev;       // 4 intrusive links, owned by the book's OrderPool
+    uint32_t poolNext;       // 4 (slot indices, not pointers)
+    uint8_t _padding[8];     // instead of 4
 
 public:
     Order() noexcept = default; // allow default construction
@@ -81,13 +89,16 @@ public:
     //       controlFlags(0), feederId(feeder)
     // {
     // }
-    Order(uint64_t orderId, double prc, uint32_t qty, Side side, uint8_t feeder, uint32_t ts) noexcept
-        : id(orderId), price(prc), quantity(qty), sideFlags(static_cast<uint8_t>(side) & 1),
-          feederId(feeder), timestamp(ts),
+    Order(uint64_t orderId, Price prc, uint32_t qty, Side side, uint8_t feeder, Timestamp ts) noexcept
+        : extra({}),         // Add this to initialize (assuming extra is a struct)
+          id(orderId), price(prc),
+          sequenceNumber(0), // Add this to initialize
+          timestamp(ts), quantity(qty), sideFlags(static_cast<uint8_t>(side) & 1),
           controlFlags(0),   // Add this to initialize
+          feederId(feeder),
           reserved(0),       // Add this to initialize
-          sequenceNumber(0), // Add this to initialize
-          extra({}),         // Add this to initialize (assuming extra is a struct)
+          poolPrev(0),       // links are set when the order rests in a book
+          poolNext(0),
           _padding{}         // Add this to initialize the padding
     {
     }
@@ -98,7 +109,7 @@ public:
         std::ostringstream oss;
         oss << "ID:" << id
             << " Side:" << (side() == Side::Buy ? "BUY" : "SELL")
-            << " Price:" << std::fixed << std::setprecision(2) << price
+            << " Price:" << std::fixed << std::setprecision(2) << DEFAULT_INSTRUMENT.to_price(price)
             << " Qty:" << quantity
             << " Time:" << timestamp;
         return oss.str();
@@ -195,7 +206,7 @@ struct std::formatter<Order> : std::formatter<std::string>
                 "ID:{} Side:{} Price:{:.2f} Qty:{}",
                 o.id,
                 (o.isBuy() ? "BUY" : "SELL"),
-                o.price,
+                DEFAULT_INSTRUMENT.to_price(o.price),
                 o.quantity),
             ctx);
     }
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "core/Order.h"
+#include "utils/concurrency/WaitStrategy.h"
+#include "utils/data_structures/spsc.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// ---------------------------
+// Per-feeder ingress lanes with a deterministic merge
+// - Each MarketFeeder owns one OrderLane (an SPSC ring): producers never
+//   touch each other's indices, so there is no producer-side contention.
+// - The engine thread merges the lanes by (timestamp, lane index); FIFO
+//   within a lane breaks the remaining ties. The merged sequence depends
+//   only on what each feeder produced, not on thread scheduling, so a
+//   multi-feeder run can be replayed.
+// - A lane's watermark promises that nothing older will be pushed to it.
+//   An empty open lane holds back orders newer than its watermark; a closed
+//   lane (feeder stopped) holds back nothing.
+// - Pushes and closes ring the ingress Doorbell so a parked engine wakes.
+
+/**
+ * @brief One feeder's SPSC lane into the engine plus its timestamp watermark.
+ */
+class OrderLane
+{
+public:
+    static constexpr uint64_t CLOSED = UINT64_MAX;
+
+    explicit OrderLane(size_t cap_pow2, Doorbell *bell = nullptr) : ring_(cap_pow2), bell_(bell) {}
+
+    // ---- producer (the owning feeder) ----
+
+    // (Re)join the merge: nothing older than ts will follow
+    void open(uint64_t ts) { watermark_.store(ts, std::memory_order_release); }
+
+    // Timestamps pushed to a lane must be non-decreasing
+    bool try_push(const Order &order)
+    {
+        if (!ring_.push(order))
+            return false;
+        watermark_.store(order.timestamp, std::memory_order_release);
+        notify();
+        return true;
+    }
+
+    // Stop holding back the other lanes; queued orders still drain
+    void close()
+    {
+        watermark_.store(CLOSED, std::memory_order_release);
+        notify();
+    }
+
+    // ---- consumer (the engine thread) ----
+
+    const Order *front() { return ring_.front(); }
+    bool pop(Order &out) { return ring_.pop(out); }
+    uint64_t watermark() const { return watermark_.load(std::memory_order_acquire); }
+
+private:
+    void notify()
+    {
+        if (bell_)
+            bell_->ring();
+    }
+
+    SPSC<Order> ring_;
+    Doorbell *bell_;
+    alignas(64) std::atomic<uint64_t> watermark_{CLOSED}; // closed until a feeder opens it
+};
+
+/**
+ * @brief Fixed set of OrderLanes merged into one deterministic order stream.
+ */
+class OrderIngress
+{
+public:
+    OrderIngress(size_t lanes, size_t lane_capacity_pow2);
+
+    size_t lane_count() const { return lanes_.size(); }
+    OrderLane &lane(size_t i) { return *lanes_[i]; }
+
+    // Move up to max_items orders into out, in merge order, stopping at the
+    // first order an open-but-idle lane could still precede. Returns the count.
+    size_t drain(std::vector<Order> &out, size_t max_items);
+
+    // Whether drain() would release at least one order (engine thread only)
+    bool ready() { return next_lane() != nullptr; }
+
+    // Rung by every lane on push/close; the engine parks on it when idle
+    Doorbell &doorbell() { return bell_; }
+
+private:
+    // Lane holding the next order in merge order, or nullptr if none may go yet
+    OrderLane *next_lane();
+
+    Doorbell bell_;
+    std::vector<std::unique_ptr<OrderLane>> lanes_; // lanes hold atomics: not movable
+};
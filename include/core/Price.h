@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+// ---------------------------
+// Fixed-point prices
+// - The book never stores floating-point prices: every price is an integer
+//   number of ticks of the instrument (int64).
+// - Integer keys compare exactly, so two orders at "the same" price always
+//   land on the same level (no ulp misses), and they can index arrays.
+// - Doubles only exist at the edges: feeders generating prices and views
+//   rendering them, both going through an Instrument.
+
+using Price = int64_t; // price in ticks
+
+struct Instrument
+{
+    double tick_size; // price increment of one tick
+
+    // Round a decimal price to the nearest tick
+    constexpr Price to_ticks(double px) const noexcept
+    {
+        const double t = px / tick_size;
+        return static_cast<Price>(t >= 0.0 ? t + 0.5 : t - 0.5);
+    }
+
+    // Decimal price of a tick count (for display only)
+    constexpr double to_price(Price ticks) const noexcept
+    {
+        return static_cast<double>(ticks) * tick_size;
+    }
+};
+
+// Instrument used by the simulator, formatters and views
+inline constexpr Instrument DEFAULT_INSTRUMENT{0.01};
@@ -1,10 +1,15 @@
 #pragma once
 
 #include "core/Order.h"
+#include "engine/OrderBookEngineConfig.h"
 #include "engine/side/OrderBookSide.h"
+#include "engine/side/LadderBookSide.h"
+#include "engine/side/DynamicBookSide.h"
+#include "engine/side/OrderIdIndex.h"
 #include "engine/match/IMatchingStrategy.h"
 
 #include "engine/match/PriceTimePriorityStrategy.h"
+#include "engine/match/DynamicStrategy.h"
 
 #include "engine/match/FillOp.h"
 #include "engine/match/MatchResult.h"
@@ -16,55 +21,112 @@
 #include <cstdint>
 #include <span>
 
-using WallTime = uint32_t; // ms since epoch
-
-class OrderBookEngine
+/**
+ * @brief Order book engine with the matching strategy and the book-side
+ *        backend as template parameters.
+ *
+ *        Strategy: provides match_side(Order &, const Side &, std::vector<FillOp> &).
+ *        BookSide: class template over the price comparator
+ *                  (OrderBookSide, LadderBookSide, DynamicBookSide).
+ *
+ *        With concrete parameters the whole add -> match -> apply path is
+ *        resolved at compile time (no virtual calls). OrderBookEngine is the
+ *        runtime-polymorphic instance (strategy object + backend from config).
+ *
+ *        If the strategy can run fused on the opposite side
+ *        (execute(Order &, Side &, Sink &)), matching fills resting orders in
+ *        place in one pass; otherwise it plans FillOps and the engine applies
+ *        them (strategies that need lookahead).
+ *
+ *        Level aggregates are coalesced per operation: fills, rests and
+ *        cancels only mark their (side, price) as touched, and one E_LevelAgg
+ *        with the final size of each touched level is published when the
+ *        add_order / add_orders / cancel_order call completes.
+ */
+template <typename Strategy, template <typename> class BookSide>
+class BasicOrderBookEngine
 {
 public:
-    static constexpr uint32_t MAX_TICKS = 1000000; // or whatever max you expect
+    using BidSide = BookSide<utils::comparator::Descending>;
+    using AskSide = BookSide<utils::comparator::Ascending>;
+
+    BasicOrderBookEngine(EventBus &bus,
+                         Strategy strategy = {},
+                         OrderBookEngineConfig config = {});
+
+    ~BasicOrderBookEngine();
 
-    OrderBookEngine(EventBus &bus, std::unique_ptr<IMatchingStrategy> strategy = std::make_unique<PriceTimePriorityStrategy>());
+    BasicOrderBookEngine(const BasicOrderBookEngine &) = delete; // bus listeners capture this
+    BasicOrderBookEngine &operator=(const BasicOrderBookEngine &) = delete;
 
     // Add a new order to the book and run matching
     void add_order(Order &order);
 
+    // Add a batch of orders: one timestamp for the batch, events published to
+    // the bus together once the whole batch is matched
+    void add_orders(std::span<Order> orders);
+
     // Cancel an existing order by ID
     void cancel_order(uint64_t order_id);
 
     // Accessors for read-only views
-    const BidBookSide &bids() const { return bids_; }
-    const AskBookSide &asks() const { return asks_; }
-
-    std::span<const WallTime> tick_wall_times() const;
+    const BidSide &bids() const { return bids_; }
+    const AskSide &asks() const { return asks_; }
 
 private:
-    BidBookSide bids_;
-    AskBookSide asks_;
-    IOrderBookSideView &bidsView_;
-    IOrderBookSideView &asksView_;
+    OrderPool pool_; // shared by both sides, declared first so it outlives them
+    BidSide bids_;
+    AskSide asks_;
 
     EventBus &bus_;
-    Ticks current_tick_ = 0;
-    Seq next_seq_ = 0;
+    IClock &clock_;
+    size_t bid_listener_ = 0; // bus handles of the sides' listeners
+    size_t ask_listener_ = 0;
+    Timestamp now_ = 0; // clock read once per operation / batch, stamped on its events
+    Seq next_seq_ = 0;  // last sequence stamped (global, never reset)
 
-    std::unique_ptr<WallTime[]> tick_times_;
-    // std::array<WallTime, MAX_TICKS> tick_times_{0};
+    bool batching_ = false;             // inside add_orders()
+    std::vector<Event> pending_events_; // events of the current batch
 
-    std::unique_ptr<IMatchingStrategy> matching_strategy_;
+    // Levels changed by the current operation (may repeat until flushed)
+    std::vector<std::pair<Order::Side, Price>> touched_levels_;
 
-    // Fast lookup for cancellations: order_id -> (side, price, iterator)
-    using OrderIterator = std::list<Order>::iterator;
-    std::unordered_map<uint64_t, std::tuple<Order::Side, double, OrderIterator>> id_lookup_;
+    Strategy matching_strategy_;
+    std::vector<FillOp> fill_ops_; // planning-mode buffer, reused across orders
 
-    void advance_tick();
-    WallTime get_current_wall_time() const;
+    // Fast lookup for cancellations and fills: order_id -> pool handle
+    // (side and price are read back from the pooled node)
+    using OrderIterator = IOrderBookSide::OrderList::iterator;
+    OrderIdIndex id_index_;
+
+    void read_clock() { now_ = clock_.now(); }
+    // Publish now, or queue for the end of the batch
+    template <typename Payload>
+    void emit(const Payload &payload);
+
+    void touch_level(Order::Side side, Price px) { touched_levels_.emplace_back(side, px); }
+    // One E_LevelAgg per touched level, with its size after the operation
+    // (every level when a listener requested a resync)
+    void flush_levels();
+
+    // Publishes fused-mode executions (Strategy::execute) straight to the bus
+    struct FillSink;
 
     // Internal helpers
-    template <typename SideType>
-    void add_order_to_side(SideType &book_side, Order &order);
-    template <typename SideType>
-    void cancel_order_on_side(SideType &book_side, Order::Side side, double price, OrderIterator order_it);
+    template <typename Side, typename OppositeSide>
+    void add_order_to_side(Side &book_side, OppositeSide &opposite, Order &order);
+    template <typename Side>
+    void cancel_order_on_side(Side &book_side, Order::Side side, Price price, OrderIterator order_it);
+    template <typename Side>
+    void apply_fill(Side &book_side, const FillOp &fill, OrderIterator order_it);
 
     // Apply FillOps from the strategy
     void apply_fill_ops(const std::vector<FillOp> &fills);
 };
+
+// Runtime-polymorphic engine: any IMatchingStrategy, backend chosen by config
+using OrderBookEngine = BasicOrderBookEngine<DynamicStrategy, DynamicBookSide>;
+
+// Fully static engines (production/benchmark configurations)
+using PriceTimeMapEngine = BasicOrderBookEngine<PriceTimePriorityStrategy, OrderBookSide>;
+using PriceTimeLadderEngine = BasicOrderBookEngine<PriceTimePriorityStrategy, LadderBookSide>;
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "engine/side/OrderIdIndex.h"
+#include "utils/time/IClock.h"
+
+#include <cstddef>
+
+// Storage backend of both book sides (runtime-selected engine only)
+enum class BookSideKind
+{
+    Map,   // std::map of levels (any price range)
+    Ladder // dense array around mid (bounded price band)
+};
+
+struct OrderBookEngineConfig
+{
+    BookSideKind book_side = BookSideKind::Map;
+    size_t ladder_window_ticks = 2048;   // initial ladder window (Ladder only)
+    size_t ladder_max_window_ticks = size_t{1} << 20; // ladder growth cap: farther prices do not rest (Ladder only)
+    size_t order_capacity = size_t{1} << 16; // resting orders preallocated in the pool
+    IdIndexMode id_index_mode = IdIndexMode::OpenAddressing;
+    size_t id_feeder_window = OrderIdIndex::DEFAULT_FEEDER_WINDOW; // DirectPerFeeder only
+    IClock *clock = nullptr; // event timestamps; nullptr: default_clock(). Must outlive the engine
+};
@@ -1,19 +1,75 @@
 // event_bus.h
 #pragma once
 #include "engine/events/Events.h"
-#include "utils/data_structures/spsc.h"
+#include "utils/concurrency/WaitStrategy.h"
+#include "utils/data_structures/ConflatingMap.h"
+#include "utils/data_structures/MulticastRing.h"
+#include <array>
 #include <atomic>
+#include <concepts>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <thread>
 #include <vector>
 
+// How a listener that falls a full ring behind is treated
 enum class Backpressure
 {
-    Drop,
-    Block,
-    SpinYield
+    Drop,     // never slows the publisher: a lapped listener skips the overwritten events
+    Block,    // publisher busy-spins until the listener frees space (lossless)
+    SpinYield, // publisher spins and yields until the listener frees space (lossless)
+    Conflate   // never slows the publisher: LevelAgg updates are merged per (side, price)
+               // while the listener lags, so it always converges to the current book;
+               // other event types are read from the ring as with Drop
+};
+
+// Which thread runs a listener's callback
+enum class Dispatch
+{
+    Pooled,   // multiplexed onto the bus's small worker pool, still in order per listener
+    Dedicated // own thread (optionally pinned): for latency-critical listeners
+};
+
+struct ListenerOptions
+{
+    EventMask mask = ALL_EVENTS; // types delivered to the callback; others are skipped unseen
+    Backpressure bp = Backpressure::SpinYield;
+    Dispatch dispatch = Dispatch::Pooled;
+    WaitStrategy wait = WaitStrategy::SpinPark; // Dedicated only: pool workers use the bus's pool_wait
+    int pin_cpu = -1;                           // Dedicated only: CPU to pin the thread to (-1: unpinned)
+    size_t conflate_levels = size_t{1} << 14;   // Conflate only: live (side, price) levels kept
+};
+
+// Batch consumers take every ready event as one contiguous span (zero-copy
+// for lossless listeners) and filter by type themselves; their mask still
+// decides wakeups and the delivered count.
+template <typename T>
+concept BatchEventListener = requires(T &t, std::span<const Event> events) { t.on_events(events); };
+
+// Optional for any listener: called (on its thread, before the event that
+// revealed it) when the sequence skips, e.g. after a Drop listener was
+// lapped. Returning true asks the publisher for a resync snapshot.
+template <typename T>
+concept GapAwareListener = requires(T &t, Seq expected, Seq got) { { t.on_gap(expected, got) } -> std::convertible_to<bool>; };
+
+// Anything with on_event(const Event &) or on_events(span) can be registered
+// as a typed listener; on_events is preferred when both exist
+template <typename T>
+concept EventListener = BatchEventListener<T> || requires(T &t, const Event &e) { t.on_event(e); };
+
+// Per-listener delivery and wakeup counters (snapshot, relaxed reads)
+struct ListenerStats
+{
+    uint64_t delivered = 0;        // events handed to the callback (after the mask)
+    uint64_t wakeups = 0;          // times the listener's thread was woken from a park (shared by a pool worker's listeners)
+    uint64_t spurious_wakeups = 0; // woke from a park with nothing to read
+    uint64_t dropped = 0;          // events lost to lapping (Drop/Conflate) or a full conflation table
+    uint64_t conflated = 0;        // LevelAgg updates merged into a newer one (Conflate listeners)
+    uint64_t gaps = 0;             // discontinuities seen in the event sequence
+    uint64_t missed = 0;           // sequence numbers skipped over by those gaps
 };
 
 class EventBus
@@ -21,24 +77,285 @@ class EventBus
 public:
     using Callback = std::function<void(const Event &)>;
 
-    explicit EventBus(size_t ring_pow2 = (1u << 12));
+    static constexpr size_t DEFAULT_POOL_THREADS = 1;
+
+    // All listeners read one shared ring of ring_pow2 events (see MulticastRing).
+    // Pooled listeners share pool_threads workers (started on first use) that
+    // idle per pool_wait; pool_threads == 0 gives every listener its own thread.
+    explicit EventBus(size_t ring_pow2 = (1u << 12), size_t pool_threads = DEFAULT_POOL_THREADS,
+                      WaitStrategy pool_wait = WaitStrategy::SpinPark);
     ~EventBus();
 
-    size_t add_listener(Callback cb, Backpressure bp = Backpressure::SpinYield);
+    size_t add_listener(Callback cb, ListenerOptions opts = {});
+    size_t add_listener(Callback cb, Backpressure bp) { return add_listener(std::move(cb), ListenerOptions{.mask = ALL_EVENTS, .bp = bp}); }
+
+    // Typed listeners: the consumer loop is instantiated per T and calls
+    // T::on_event directly (inlinable for final/non-virtual listeners), with
+    // one indirect call per delivered batch instead of a std::function call
+    // per event. The mask defaults to T::EVENT_MASK when T declares one.
+    // The bus shares ownership of the listener until it is removed.
+    template <EventListener T>
+    size_t add_listener(std::shared_ptr<T> listener, ListenerOptions opts = default_options<T>())
+    {
+        T *self = listener.get();
+        return attach(self, &drain_as<T>, std::move(listener), opts);
+    }
+
+    // Non-owning: the listener must outlive remove_listener (or the bus)
+    template <EventListener T>
+    size_t add_listener(T &listener, ListenerOptions opts = default_options<T>())
+    {
+        return attach(&listener, &drain_as<T>, nullptr, opts);
+    }
+
+    template <typename T>
+    static constexpr ListenerOptions default_options()
+    {
+        ListenerOptions opts;
+        if constexpr (requires { T::EVENT_MASK; })
+            opts.mask = T::EVENT_MASK;
+        return opts;
+    }
     void remove_listener(size_t h);
     void stop_all();
 
+    ListenerStats listener_stats(size_t h) const;
+    size_t thread_count() const; // pool workers + dedicated listener threads
+    size_t parked_threads() const { return bell_.sleepers(); } // asleep until the next wanted publish
+
     // single-writer only
     void publish(const Event &e);
+    // single-writer only: the whole batch goes to each listener in turn
+    void publish(std::span<const Event> events);
 
     template <typename Payload>
-    void operator()(Ticks ts, Seq seq, const Payload &payload);
+    void operator()(Timestamp ts, Seq seq, const Payload &payload);
+
+    // Any thread: ask the publisher to republish full state (see GapAwareListener)
+    void request_resync() { resync_requested_.store(true, std::memory_order_relaxed); }
+    // Publisher: whether a resync was requested since the last call (clears it)
+    bool take_resync_request()
+    {
+        return resync_requested_.load(std::memory_order_relaxed) &&
+               resync_requested_.exchange(false, std::memory_order_relaxed);
+    }
 
 private:
+    struct Worker;
     struct Endpoint;
 
-    static void push_one(Endpoint &ep, const Event &e);
+    // Consume up to max_items pending events (returned), running the listener
+    // on those its mask wants (added to wanted)
+    using DrainFn = size_t (*)(EventBus &, Endpoint &, size_t max_items, size_t &wanted);
+    // Latest LevelAgg per (side, price) for a Conflate listener
+    using LevelTable = ConflatingMap<uint64_t, Event>;
+
+    struct Endpoint
+    {
+        MulticastRing<Event>::Cursor *cursor = nullptr; // position in the shared ring
+        void *self = nullptr;                           // the listener (T * for drain_as<T>)
+        DrainFn drain = nullptr;
+        std::shared_ptr<void> owner; // keeps owned listeners alive; empty for references
+        ListenerOptions opts;
+        std::atomic<bool> run{false};
+        std::thread th;           // Dedicated only
+        Worker *worker = nullptr; // Pooled only: the one worker that serves this listener
+        std::unique_ptr<LevelTable> levels; // Conflate only (written by the publisher)
+        std::atomic<uint64_t> overflow{0};  // Conflate only: updates for keys that did not fit
+        Seq next_seq = 0;                   // expected seq of the next ring event (0: not known yet)
+
+        // written by the serving thread only, read by listener_stats()
+        std::atomic<uint64_t> delivered{0};
+        std::atomic<uint64_t> wakeups{0};
+        std::atomic<uint64_t> spurious_wakeups{0};
+        std::atomic<uint64_t> gaps{0};
+        std::atomic<uint64_t> missed{0};
+    };
 
-    size_t ring_pow2_;
+    static constexpr size_t POOL_BATCH = 256; // max events per listener per worker sweep
+
+    template <typename T>
+    static size_t drain_as(EventBus &bus, Endpoint &ep, size_t max_items, size_t &wanted);
+    template <typename T>
+    static size_t drain_conflated_as(EventBus &bus, Endpoint &ep, size_t max_items, size_t &wanted);
+    template <typename T>
+    static void call(T &target, const Event &ev);
+    template <typename T>
+    static void track_seq(EventBus &bus, Endpoint &ep, T &target, Seq seq);
+    template <typename T>
+    static void track_seqs(EventBus &bus, Endpoint &ep, T &target, std::span<const Event> events);
+
+    static uint64_t level_key(const E_LevelAgg &lvl)
+    {
+        return (static_cast<uint64_t>(lvl.px) << 1) | static_cast<uint64_t>(lvl.side);
+    }
+
+    size_t attach(void *self, DrainFn drain, std::shared_ptr<void> owner, ListenerOptions opts);
+    void run_dedicated(Endpoint &ep);
+    void run_worker(Worker &w);
+    Worker &least_loaded_worker();
+
+    // Wait (per the slowest lossless listener's policy) until n slots are free
+    size_t wait_for_slots(size_t n);
+    // Count a published batch per type and wake the listeners that want it
+    void announce(const Event *events, size_t n);
+    void conflate(const Event *events, size_t n); // LevelAggs into every Conflate listener's table
+    // Events of the masked types published so far (listener threads)
+    uint64_t published_matching(EventMask mask) const;
+    // Publisher blocked on a full ring: gating listeners must not park
+    bool ring_full() const { return ring_full_.load(std::memory_order_relaxed); }
+
+    MulticastRing<Event> ring_;
+    Doorbell bell_; // rung after every publish with the batch's type mask
+    std::array<std::atomic<uint64_t>, EVENT_TYPE_COUNT> published_by_type_{}; // single writer
     std::vector<std::unique_ptr<Endpoint>> listeners_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::mutex conflating_mu_;                      // publisher vs. add/remove of Conflate listeners
+    std::vector<Endpoint *> conflating_;            // listeners whose LevelAggs go through a LevelTable
+    std::atomic<bool> has_conflating_{false};       // lets announce() skip the lock
+    size_t pool_threads_;
+    WaitStrategy pool_wait_;
+    bool yield_when_full_ = false; // a SpinYield listener gates the ring
+    std::atomic<bool> ring_full_{false}; // publisher waiting on the slowest gating cursor
+    std::atomic<bool> resync_requested_{false};
 };
+
+template <typename T>
+void EventBus::call(T &target, const Event &ev)
+{
+    if constexpr (requires { target.on_event(ev); })
+        target.on_event(ev);
+    else if constexpr (BatchEventListener<T>)
+        target.on_events(std::span<const Event>(&ev, 1));
+    else
+        target(ev);
+}
+
+template <typename T>
+void EventBus::track_seq(EventBus &bus, Endpoint &ep, T &target, Seq seq)
+{
+    if (seq != ep.next_seq && ep.next_seq != 0) [[unlikely]]
+    {
+        ep.gaps.fetch_add(1, std::memory_order_relaxed);
+        if (seq > ep.next_seq)
+            ep.missed.fetch_add(seq - ep.next_seq, std::memory_order_relaxed);
+        if constexpr (GapAwareListener<T>)
+        {
+            if (ep.run.load(std::memory_order_relaxed) && target.on_gap(ep.next_seq, seq))
+                bus.request_resync();
+        }
+    }
+    ep.next_seq = seq + 1;
+}
+
+template <typename T>
+void EventBus::track_seqs(EventBus &bus, Endpoint &ep, T &target, std::span<const Event> events)
+{
+    // a contiguous run only needs its ends checked
+    track_seq(bus, ep, target, events.front().seq);
+    if (events.back().seq - events.front().seq == events.size() - 1) [[likely]]
+        ep.next_seq = events.back().seq + 1;
+    else
+        for (const Event &ev : events.subspan(1))
+            track_seq(bus, ep, target, ev.seq);
+}
+
+template <typename T>
+size_t EventBus::drain_as(EventBus &bus, Endpoint &ep, size_t max_items, size_t &wanted)
+{
+    if (ep.levels)
+        return drain_conflated_as<T>(bus, ep, max_items, wanted);
+
+    T &target = *static_cast<T *>(ep.self);
+    size_t n = 0;
+    if constexpr (BatchEventListener<T>)
+    {
+        // Whole runs straight from the ring, acknowledged with one cursor store
+        const size_t consumed = bus.ring_.poll_batch(*ep.cursor, [&](std::span<const Event> events)
+                                                     {
+            track_seqs(bus, ep, target, events);
+            size_t batch_wanted = 0;
+            for (const Event &ev : events)
+                batch_wanted += (ep.opts.mask & event_bit(ev.type)) != 0;
+            // nothing wanted in this run: skip the call entirely
+            if (batch_wanted && ep.run.load(std::memory_order_relaxed)) // stop immediately if disabled
+                target.on_events(events);
+            n += batch_wanted; }, max_items);
+        if (n)
+            ep.delivered.fetch_add(n, std::memory_order_relaxed);
+        wanted += n;
+        return consumed;
+    }
+    else
+    {
+        // The cursor moves past every event; only wanted ones reach the listener
+        const size_t consumed = bus.ring_.poll(*ep.cursor, [&](const Event &ev)
+                                               {
+            track_seq(bus, ep, target, ev.seq);
+            if (!(ep.opts.mask & event_bit(ev.type)))
+                return;
+            if (ep.run.load(std::memory_order_relaxed)) // stop immediately if disabled
+                call(target, ev);
+            ++n; }, max_items);
+        if (n)
+            ep.delivered.fetch_add(n, std::memory_order_relaxed);
+        wanted += n;
+        return consumed;
+    }
+}
+
+template <typename T>
+size_t EventBus::drain_conflated_as(EventBus &bus, Endpoint &ep, size_t max_items, size_t &wanted)
+{
+    T &target = *static_cast<T *>(ep.self);
+    size_t n = 0;
+
+    // Ring first, minus LevelAgg: those come from the table, which is always
+    // at least as new as anything read from the ring before it
+    const EventMask ring_mask = ep.opts.mask & ~event_bit(EventType::LevelAgg);
+    size_t consumed;
+    if (!ring_mask)
+    {
+        consumed = bus.ring_.skip_all(*ep.cursor);
+        ep.next_seq = 0; // not reading the ring: nothing to check against
+    }
+    else
+        consumed = bus.ring_.poll(*ep.cursor, [&](const Event &ev)
+                                  {
+            track_seq(bus, ep, target, ev.seq);
+            if (!(ring_mask & event_bit(ev.type)))
+                return;
+            if (ep.run.load(std::memory_order_relaxed))
+                call(target, ev);
+            ++n; }, max_items);
+
+    if (ep.opts.mask & event_bit(EventType::LevelAgg))
+    {
+        Event buf[64]; // table entries are not contiguous: batch listeners get copies
+        size_t k = 0;
+        auto flush = [&]
+        {
+            if (k && ep.run.load(std::memory_order_relaxed))
+            {
+                if constexpr (BatchEventListener<T>)
+                    target.on_events(std::span<const Event>(buf, k));
+                else
+                    for (size_t j = 0; j < k; ++j)
+                        call(target, buf[j]);
+            }
+            n += k;
+            k = 0;
+        };
+        consumed += ep.levels->drain([&](uint64_t, const Event &ev)
+                                     {
+            buf[k++] = ev;
+            if (k == std::size(buf))
+                flush(); }, max_items);
+        flush();
+    }
+
+    if (n)
+        ep.delivered.fetch_add(n, std::memory_order_relaxed);
+    wanted += n;
+    return std::min(consumed, max_items);
+}
@@ -1,28 +1,29 @@
 // events.h
 #pragma once
 #include "core/Order.h"
+#include "utils/time/Timestamp.h"
+#include <cstddef>
 #include <cstdint>
 #include <format>
 
-using Seq = uint32_t;
-using Ticks = uint32_t;
+using Seq = uint64_t; // global event sequence: starts at 1, never resets or wraps
 
 // We keep payload POD only
-// structs uint64_t, int64_t, double and Order::Side enum class
+// structs uint64_t, int64_t, Price and Order::Side enum class
 // so union inside Event is safe and well-defined
 // if we have no POD switch to std::variant
 struct E_OrderAdded
 {
     uint64_t id;
     Order::Side side;
-    double px;
+    Price px;
     int64_t qty;
 };
 
 struct E_OrderUpdated
 {
     uint64_t id;
-    double px;
+    Price px;
     int64_t qty;
 }; // after partial fill/change
 
@@ -35,14 +36,14 @@ struct E_Fill
 {
     uint64_t makerId;
     uint64_t takerId;
-    double px;
+    Price px;
     int64_t qty;
 };
 
 struct E_LevelAgg
 {
     Order::Side side;
-    double px;
+    Price px;
     int64_t aggQty;
 };
 
@@ -54,12 +55,18 @@ enum class EventType : uint8_t
     Fill,
     LevelAgg
 };
+inline constexpr size_t EVENT_TYPE_COUNT = 5;
+
+// Subscription mask: one bit per EventType
+using EventMask = uint32_t;
+inline constexpr EventMask event_bit(EventType t) { return EventMask{1} << static_cast<uint8_t>(t); }
+inline constexpr EventMask ALL_EVENTS = (EventMask{1} << EVENT_TYPE_COUNT) - 1;
 
 struct Event
 {
     EventType type;
+    Timestamp ts;
     Seq seq;
-    Ticks ts;
     union
     {
         E_OrderAdded added;
@@ -68,33 +75,33 @@ struct Event
         E_Fill fill;
         E_LevelAgg level;
     } d;
-    static Event make(Ticks ts, Seq s, const E_OrderAdded &x)
+    static Event make(Timestamp ts, Seq s, const E_OrderAdded &x)
     {
-        Event e{EventType::OrderAdded, s, ts};
+        Event e{EventType::OrderAdded, ts, s};
         e.d.added = x;
         return e;
     }
-    static Event make(Ticks ts, Seq s, const E_OrderUpdated &x)
+    static Event make(Timestamp ts, Seq s, const E_OrderUpdated &x)
     {
-        Event e{EventType::OrderUpdated, s, ts};
+        Event e{EventType::OrderUpdated, ts, s};
         e.d.updated = x;
         return e;
     }
-    static Event make(Ticks ts, Seq s, const E_OrderRemoved &x)
+    static Event make(Timestamp ts, Seq s, const E_OrderRemoved &x)
     {
-        Event e{EventType::OrderRemoved, s, ts};
+        Event e{EventType::OrderRemoved, ts, s};
         e.d.removed = x;
         return e;
     }
-    static Event make(Ticks ts, Seq s, const E_Fill &x)
+    static Event make(Timestamp ts, Seq s, const E_Fill &x)
     {
-        Event e{EventType::Fill, s, ts};
+        Event e{EventType::Fill, ts, s};
         e.d.fill = x;
         return e;
     }
-    static Event make(Ticks ts, Seq s, const E_LevelAgg &x)
+    static Event make(Timestamp ts, Seq s, const E_LevelAgg &x)
     {
-        Event e{EventType::LevelAgg, s, ts};
+        Event e{EventType::LevelAgg, ts, s};
         e.d.level = x;
         return e;
     }
@@ -111,7 +118,7 @@ struct std::formatter<E_OrderAdded> : std::formatter<std::string>
             std::format("ID:{} Side:{} Price:{:.2f} Qty:{}",
                         x.id,
                         static_cast<int>(x.side),
-                        x.px,
+                        DEFAULT_INSTRUMENT.to_price(x.px),
                         x.qty),
             ctx);
     }
@@ -125,7 +132,7 @@ struct std::formatter<E_OrderUpdated> : std::formatter<std::string>
     auto format(const E_OrderUpdated &x, FormatContext &ctx) const
     {
         return std::formatter<std::string>::format(
-            std::format("ID:{} Price:{:.2f} Qty:{}", x.id, x.px, x.qty), ctx);
+            std::format("ID:{} Price:{:.2f} Qty:{}", x.id, DEFAULT_INSTRUMENT.to_price(x.px), x.qty), ctx);
     }
 };
 
@@ -148,7 +155,7 @@ struct std::formatter<E_LevelAgg> : std::formatter<std::string>
     auto format(const E_LevelAgg &x, FormatContext &ctx) const
     {
         return std::formatter<std::string>::format(
-            std::format("Side:{} Price:{:.2f} AggQty:{}", static_cast<int>(x.side), x.px, x.aggQty),
+            std::format("Side:{} Price:{:.2f} AggQty:{}", static_cast<int>(x.side), DEFAULT_INSTRUMENT.to_price(x.px), x.aggQty),
             ctx);
     }
 };
@@ -164,7 +171,7 @@ struct std::formatter<E_Fill> : std::formatter<std::string>
             std::format("Maker:{} Taker:{} Price:{:.2f} Qty:{}",
                         x.makerId,
                         x.takerId,
-                        x.px,
+                        DEFAULT_INSTRUMENT.to_price(x.px),
                         x.qty),
             ctx);
     }
@@ -5,4 +5,8 @@ struct IEventListener
 {
     virtual ~IEventListener() = default;
     virtual void on_event(const Event &) = 0;
+
+    // Event types on_event consumes: pass as ListenerOptions::mask so the bus
+    // skips the rest. Listeners narrow it by redeclaring EVENT_MASK.
+    static constexpr EventMask EVENT_MASK = ALL_EVENTS;
 };
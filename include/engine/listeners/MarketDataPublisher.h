@@ -16,6 +16,8 @@ public:
     explicit MarketDataPublisher(std::unique_ptr<Dashboard> dashboard);
     ~MarketDataPublisher();
     // Called on each event via EventBus
+    // Only paces redraws (the views hold the data): trades are enough to count
+    static constexpr EventMask EVENT_MASK = event_bit(EventType::Fill);
     void on_event(const Event &e);
     void handle_key(char key);
 
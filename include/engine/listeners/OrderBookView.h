@@ -6,25 +6,33 @@
 #include <mutex>
 #include <vector>
 #include <optional>
+#include <span>
 
 /**
  * @brief Maintains an incremental L2 snapshot of the order book.
  *        Listens to EventBus and updates internal state using LevelAgg events.
  */
-class OrderBookView : public IEventListener
+class OrderBookView final : public IEventListener
 {
 public:
     OrderBookView() = default;
 
     // IEventListener interface
+    static constexpr EventMask EVENT_MASK = event_bit(EventType::LevelAgg);
     void on_event(const Event &e) override;
+    // Batch delivery from the EventBus: one lock per batch
+    void on_events(std::span<const Event> events);
+    // Missed updates may hide removed levels: start over and ask for a snapshot
+    bool on_gap(Seq expected, Seq got);
 
     // Query methods
-    std::optional<int64_t> get_qty_at_price(Order::Side side, double px) const;
+    std::optional<int64_t> get_qty_at_price(Order::Side side, Price px) const;
     std::vector<PriceLevelView> top_n(Order::Side side, size_t n) const;
 
 private:
+    void apply_level(const E_LevelAgg &lvl); // mtx_ held
+
     mutable std::mutex mtx_;
-    std::map<double, int64_t, std::greater<>> bid_levels_; // descending (best bid = begin)
-    std::map<double, int64_t, std::less<>> ask_levels_;    // ascending (best ask = begin)
+    std::map<Price, int64_t, std::greater<>> bid_levels_; // descending (best bid = begin)
+    std::map<Price, int64_t, std::less<>> ask_levels_;    // ascending (best ask = begin)
 };
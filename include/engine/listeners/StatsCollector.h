@@ -8,6 +8,7 @@
 #include <optional>
 #include <cstdint>
 #include <memory>
+#include <span>
 
 using TradeBuffer = SPSC<TradeInfo>;
 
@@ -16,20 +17,24 @@ using TradeBuffer = SPSC<TradeInfo>;
  *        e.g., total orders, fills, cancellations, top-of-book updates.
  *        Also pushes executed trades into a TradeBuffer for renderers.
  */
-class StatsCollector : public IEventListener
+class StatsCollector final : public IEventListener
 {
 public:
     explicit StatsCollector(std::shared_ptr<TradeBuffer> trade_buffer = nullptr)
         : trade_buffer_(std::move(trade_buffer)) {}
 
+    static constexpr EventMask EVENT_MASK = event_bit(EventType::Fill) | event_bit(EventType::OrderAdded) |
+                                            event_bit(EventType::OrderRemoved) | event_bit(EventType::LevelAgg);
     void on_event(const Event &e) override;
+    // Batch delivery from the EventBus: counters and top of book updated once per batch
+    void on_events(std::span<const Event> events);
 
     uint64_t total_orders() const { return total_orders_.load(); }
     uint64_t total_fills() const { return total_fills_.load(); }
     uint64_t total_cancels() const { return total_cancels_.load(); }
 
-    std::optional<int64_t> last_best_bid() const;
-    std::optional<int64_t> last_best_ask() const;
+    std::optional<Price> last_best_bid() const;
+    std::optional<Price> last_best_ask() const;
 
     // --- Derived stats ---
     uint64_t trade_count() const { return total_fills(); }
@@ -42,8 +47,8 @@ private:
     std::atomic<uint64_t> total_cancels_ = 0;
 
     mutable std::mutex mtx_;
-    int64_t best_bid_ = 0;
-    int64_t best_ask_ = 0;
+    Price best_bid_ = 0;
+    Price best_ask_ = 0;
 
     std::shared_ptr<TradeBuffer> trade_buffer_;
 };
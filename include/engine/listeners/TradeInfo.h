@@ -1,21 +1,21 @@
 #pragma once
 #include <cstdint>
 #include "core/Order.h" // for Order::Side
+#include "utils/time/Timestamp.h"
 
 /**
  * @brief Public-facing representation of an executed trade.
  *        Derived from engine FillOps but enriched with context
  *        useful for views, renderers, and logging.
  */
-using Ticks = uint32_t;
 struct TradeInfo
 {
     uint64_t makerId;
     uint64_t takerId;
-    double price; // price, keep double to match E_Fill
+    Price price;  // price in ticks, matches E_Fill
     int64_t qty;  // executed quantity
-    Ticks ts;     // timestamp (ticks)
-    uint32_t seq;
+    Timestamp ts; // engine time of the fill (ns)
+    uint64_t seq; // global event sequence of the fill
 };
 
 template <>
@@ -29,7 +29,7 @@ struct std::formatter<TradeInfo> : std::formatter<std::string>
                         x.ts,      // timestamp
                         x.makerId, // then maker
                         x.takerId, // then taker
-                        x.price,   // price
+                        DEFAULT_INSTRUMENT.to_price(x.price), // price
                         x.qty),    // quantity
             ctx);
     }
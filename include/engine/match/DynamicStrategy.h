@@ -0,0 +1,37 @@
+#pragma once
+
+#include "engine/match/IMatchingStrategy.h"
+#include "engine/match/PriceTimePriorityStrategy.h"
+#include "engine/side/DynamicBookSide.h"
+
+#include <concepts>
+#include <memory>
+
+/**
+ * @brief Runtime-polymorphic strategy slot for the templated engine:
+ *        holds any IMatchingStrategy and calls it virtually.
+ *        Runtime-selected sides are unwrapped first, so the strategy sees
+ *        the concrete backend (PriceTimePriorityStrategy then dispatches
+ *        to its static path).
+ */
+class DynamicStrategy
+{
+public:
+    DynamicStrategy() : strategy_(std::make_unique<PriceTimePriorityStrategy>()) {}
+    template <std::derived_from<IMatchingStrategy> S>
+    DynamicStrategy(std::unique_ptr<S> strategy) : strategy_(std::move(strategy)) {}
+
+    template <typename Compare>
+    MatchResult match_side(Order &incoming, const DynamicBookSide<Compare> &opposite, std::vector<FillOp> &out)
+    {
+        return strategy_->match(incoming, opposite.impl(), out);
+    }
+
+    MatchResult match_side(Order &incoming, const IOrderBookSideView &opposite, std::vector<FillOp> &out)
+    {
+        return strategy_->match(incoming, opposite, out);
+    }
+
+private:
+    std::unique_ptr<IMatchingStrategy> strategy_;
+};
@@ -1,4 +1,6 @@
 #pragma once
+#include "core/Price.h"
+
 #include <cstdint>
 #include <format>
 
@@ -6,7 +8,7 @@ struct FillOp
 {
     uint64_t makerOrderId; // resting order consumed
     uint32_t quantity;     // executed quantity
-    double price;          // execution price
+    Price price;           // execution price (ticks)
 };
 
 // --- FillOp ---
@@ -20,7 +22,7 @@ struct std::formatter<FillOp> : std::formatter<std::string>
             std::format("makerOrderId:{} Qty:{} Price:{:.2f}",
                         f.makerOrderId,
                         f.quantity,
-                        f.price),
+                        DEFAULT_INSTRUMENT.to_price(f.price)),
             ctx);
     }
 };
\ No newline at end of file
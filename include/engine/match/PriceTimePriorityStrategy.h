@@ -2,9 +2,23 @@
 
 #include "engine/match/IMatchingStrategy.h"
 
+#include <algorithm>
+
 /**
  * @brief FIFO (Price-Time Priority) matcher.
  *        Walks best price → worse; FIFO within each level.
+ *
+ *        Two execution modes:
+ *        - Planning (match / match_side): read-only walk that appends
+ *          FillOps; the engine applies them afterwards. match_side() is the
+ *          statically dispatched form for concrete sides (OrderBookSide /
+ *          LadderBookSide), the virtual match() forwards to it for the
+ *          known backends (by the view's SideBackend tag) and walks any
+ *          other view through its interface.
+ *        - Fused (execute): one mutating pass over a concrete side that fills
+ *          resting orders in place, removes exhausted orders and levels, and
+ *          reports every step to a sink that publishes events. No FillOp
+ *          buffer and no second lookup per maker.
  */
 class PriceTimePriorityStrategy : public IMatchingStrategy
 {
@@ -13,4 +27,95 @@ public:
         Order &incoming,
         const IOrderBookSideView &opposite,
         std::vector<FillOp> &out) override;
+
+    // SideView: visit_levels(fn(Price, const Orders &) -> bool), best to worst
+    template <typename SideView>
+    MatchResult match_side(
+        Order &incoming,
+        const SideView &opposite,
+        std::vector<FillOp> &out);
+
+    // Side: visit_levels + consume_levels(fn(Price, OrderList &) -> bool)
+    // Sink, called in this order for every execution:
+    //   on_fill(const Order &maker, Price px, uint32_t qty)  maker already reduced
+    //   on_maker_filled(const Order &maker)                  before it leaves the book
+    //   on_level(Order::Side side, Price px, const OrderList &level)  after the fill
+    // incoming.quantity is left at the unfilled remainder.
+    template <typename Side, typename Sink>
+    MatchResult execute(Order &incoming, Side &opposite, Sink &sink);
+
+    // Price acceptance based on side/market
+    static bool price_ok(const Order &incoming, Price levelPrice)
+    {
+        if (incoming.isMarket())
+            return true;
+        return incoming.isBuy() ? (incoming.price >= levelPrice)
+                                : (incoming.price <= levelPrice);
+    }
+
+    // FOK pre-check: can the crossing levels fill the whole order?
+    template <typename SideView>
+    static bool fully_fillable(const Order &incoming, const SideView &opposite)
+    {
+        uint64_t canFill = 0;
+        opposite.visit_levels([&](Price px, const auto &orders)
+                              {
+            if (!price_ok(incoming, px))
+                return false;
+            for (const Order &resting : orders)
+                canFill += resting.quantity;
+            return canFill < incoming.quantity; });
+        return canFill >= incoming.quantity;
+    }
 };
+
+// Defined here so the engine's sink inlines into the walk
+template <typename Side, typename Sink>
+MatchResult PriceTimePriorityStrategy::execute(Order &incoming, Side &opposite, Sink &sink)
+{
+    MatchResult result{};
+    if (incoming.quantity == 0)
+        return result;
+
+    if (incoming.isFOK() && !fully_fillable(incoming, opposite))
+    {
+        result.allOrNoneFailed = true;
+        return result; // book untouched
+    }
+
+    uint32_t remaining = incoming.quantity;
+
+    opposite.consume_levels([&](Price px, auto &orders)
+                            {
+        if (!price_ok(incoming, px))
+            return false;
+        for (auto it = orders.begin(); it != orders.end();)
+        {
+            const uint32_t exec = std::min(remaining, it->quantity);
+            if (exec == 0)
+            {
+                ++it;
+                continue;
+            }
+
+            orders.reduce(it, exec);
+            remaining -= exec;
+            const Order::Side maker_side = it->side();
+            sink.on_fill(*it, px, exec);
+
+            if (it->quantity == 0)
+            {
+                sink.on_maker_filled(*it);
+                it = orders.erase(it);
+            }
+            sink.on_level(maker_side, px, orders);
+
+            if (remaining == 0)
+                return false;
+        }
+        return true; });
+
+    result.filledQty = incoming.quantity - remaining;
+    incoming.quantity = remaining;
+    return result;
+}
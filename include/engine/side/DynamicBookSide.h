@@ -0,0 +1,49 @@
+#pragma once
+#include <memory>
+#include <utility>
+#include "IOrderBookSide.h"
+#include "engine/OrderBookEngineConfig.h"
+#include "utils/Comparator.h"
+
+/**
+ * @brief Book side whose backend is picked at runtime from
+ *        OrderBookEngineConfig::book_side. Lets the runtime-polymorphic
+ *        OrderBookEngine share the templated engine code: every call is
+ *        forwarded to the chosen backend through IOrderBookSide.
+ */
+template <typename Compare>
+class DynamicBookSide final : public IOrderBookSide
+{
+public:
+    DynamicBookSide(OrderPool &pool, const OrderBookEngineConfig &config);
+
+    // The backend itself (lets matchers dispatch on its concrete type)
+    const IOrderBookSide &impl() const { return *impl_; }
+
+    // ---- IOrderBookSideView ----
+    std::optional<Price> best_price() const override { return impl_->best_price(); }
+    std::optional<Price> next_price(Price price) const override { return impl_->next_price(price); }
+    size_t num_levels() const override { return impl_->num_levels(); }
+    void for_each_level(const std::function<void(const PriceLevelView &)> &fn) const override { impl_->for_each_level(fn); }
+    void for_each_order_at_price(Price price, const std::function<void(const Order &)> &fn) const override { impl_->for_each_order_at_price(price, fn); }
+
+    // ---- engine-facing mutators ----
+    void add_order(const Order &o) override { impl_->add_order(o); }
+    OrderList::iterator add_order_and_get_iterator(const Order &o) override { return impl_->add_order_and_get_iterator(o); }
+    bool accepts_price(Price price) const override { return impl_->accepts_price(price); }
+
+    OrderList &get_orders_at_price(Price price) override { return impl_->get_orders_at_price(price); }
+    const OrderList &get_orders_at_price(Price price) const override { return std::as_const(*impl_).get_orders_at_price(price); }
+
+    void remove_price_level(Price price) override { impl_->remove_price_level(price); }
+    bool empty_at_price(Price price) const override { return impl_->empty_at_price(price); }
+
+    // ---- IEventListener ----
+    void on_event(const Event &e) override { impl_->on_event(e); }
+
+private:
+    std::unique_ptr<IOrderBookSide> impl_;
+};
+
+using BidDynamicSide = DynamicBookSide<utils::comparator::Descending>;
+using AskDynamicSide = DynamicBookSide<utils::comparator::Ascending>;
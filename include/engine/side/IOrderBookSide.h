@@ -0,0 +1,41 @@
+#pragma once
+
+#include "core/Order.h"
+#include "engine/side/IOrderBookSideView.h"
+#include "engine/events/IEventListener.h"
+#include "engine/side/OrderPool.h"
+
+/**
+ * @brief Engine-facing side of the book: the read-only view plus the mutators
+ *        the engine needs. Implemented by every storage backend
+ *        (OrderBookSide = std::map, LadderBookSide = dense array), so the
+ *        backend can be chosen per OrderBookEngine instance.
+ *        Resting orders live in an OrderPool; each level is an intrusive
+ *        OrderQueue of pool nodes.
+ */
+class IOrderBookSide : public IOrderBookSideView, public IEventListener
+{
+public:
+    using OrderList = OrderQueue;
+
+    // Book sides observe order lifecycle events, never LevelAgg
+    static constexpr EventMask EVENT_MASK = ALL_EVENTS & ~event_bit(EventType::LevelAgg);
+
+    // add an order
+    virtual void add_order(const Order &o) = 0;
+    virtual OrderList::iterator add_order_and_get_iterator(const Order &o) = 0;
+
+    // expose orders at price (non-const for engine use)
+    virtual OrderList &get_orders_at_price(Price price) = 0;
+    virtual const OrderList &get_orders_at_price(Price price) const = 0;
+
+    virtual void remove_price_level(Price price) = 0;
+    virtual bool empty_at_price(Price price) const = 0;
+
+    // false: this backend cannot rest an order at price (bounded backends)
+    virtual bool accepts_price(Price) const { return true; }
+
+protected:
+    IOrderBookSide() = default;
+    explicit IOrderBookSide(SideBackend backend) : IOrderBookSideView(backend) {}
+};
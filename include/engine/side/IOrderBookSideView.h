@@ -6,13 +6,29 @@
 #include <cstdint>
 #include <optional>
 #include <functional>
+// Concrete backend behind a view, so a hot path can static_cast to it
+// (one byte compare) instead of trying dynamic_casts
+enum class SideBackend : uint8_t
+{
+    Other, // wrappers, test doubles: use the virtual interface
+    BidMap,
+    AskMap,
+    BidLadder,
+    AskLadder,
+};
+
 class IOrderBookSideView
 {
 public:
     virtual ~IOrderBookSideView() = default;
 
+    SideBackend backend() const { return backend_; }
+
     // return best price (nullopt if empty)
-    virtual std::optional<double> best_price() const = 0;
+    virtual std::optional<Price> best_price() const = 0;
+
+    // next live price strictly worse than `price` (nullopt if none)
+    virtual std::optional<Price> next_price(Price price) const = 0;
 
     // total number of levels
     virtual size_t num_levels() const = 0;
@@ -21,5 +37,13 @@ public:
     virtual void for_each_level(const std::function<void(const PriceLevelView &)> &fn) const = 0;
 
     // iterate over orders at a specific price
-    virtual void for_each_order_at_price(double price, const std::function<void(const Order &)> &fn) const = 0;
+    virtual void for_each_order_at_price(Price price, const std::function<void(const Order &)> &fn) const = 0;
+
+protected:
+    IOrderBookSideView() = default;
+    // Only for the final backends: the tag promises what static_cast may assume
+    explicit IOrderBookSideView(SideBackend backend) : backend_(backend) {}
+
+private:
+    SideBackend backend_ = SideBackend::Other;
 };
\ No newline at end of file
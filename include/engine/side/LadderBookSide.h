@@ -0,0 +1,157 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <functional>
+#include "IOrderBookSide.h"
+#include "utils/Comparator.h"
+#include "utils/data_structures/OccupancyBitmap.h"
+#include "engine/events/IEventListener.h" // for Event + EventType
+
+/**
+ * @brief Dense backend: price levels live in a contiguous array indexed by
+ *        tick offset from a movable anchor (base_ = price of slot 0).
+ *
+ *        - best_price() is O(1) through the cached best slot.
+ *        - The next live level is found through a hierarchical occupancy
+ *          bitmap, so sweeps through thin books cost O(1) per level.
+ *        - Adding/removing a level touches one slot, no node allocation.
+ *        - Prices outside the window recenter it around the live levels;
+ *          if the live band no longer fits, the window doubles, up to
+ *          max_window_ticks. A price that would stretch it further is
+ *          refused (accepts_price). Lookups never move the window.
+ *
+ *        Meant for instruments trading in a bounded band around mid.
+ */
+template <typename Compare>
+class LadderBookSide final : public IOrderBookSide
+{
+public:
+    using OrderList = IOrderBookSide::OrderList;
+    using PriceLevel = OrderList;
+
+    static constexpr SideBackend BACKEND =
+        std::is_same_v<Compare, utils::comparator::Descending> ? SideBackend::BidLadder : SideBackend::AskLadder;
+
+    static constexpr size_t DEFAULT_WINDOW_TICKS = 2048;
+    static constexpr size_t DEFAULT_MAX_WINDOW_TICKS = size_t{1} << 20; // ~32 MB of levels
+
+    // Standalone side with its own pool, or a side drawing from a shared pool
+    explicit LadderBookSide(size_t window_ticks = DEFAULT_WINDOW_TICKS,
+                            size_t max_window_ticks = DEFAULT_MAX_WINDOW_TICKS);
+    LadderBookSide(OrderPool &pool, size_t window_ticks = DEFAULT_WINDOW_TICKS,
+                   size_t max_window_ticks = DEFAULT_MAX_WINDOW_TICKS);
+
+    // ---- IOrderBookSideView ----
+    std::optional<Price> best_price() const override;
+    std::optional<Price> next_price(Price price) const override;
+    size_t num_levels() const override;
+    void for_each_level(const std::function<void(const PriceLevelView &)> &fn) const override;
+    void for_each_order_at_price(Price price, const std::function<void(const Order &)> &fn) const override;
+
+    // ---- static iteration (non-virtual, inlinable, early exit) ----
+    // fn(Price, const OrderList &) -> bool, best to worst; return false to stop
+    template <typename Fn>
+    void visit_levels(Fn &&fn) const
+    {
+        for (size_t i = best_; i != NO_LEVEL; i = next_live(i))
+            if (!fn(base_ + static_cast<Price>(i), levels_[i]))
+                return;
+    }
+
+    // fn(const Order &) -> bool, FIFO within the level; return false to stop
+    template <typename Fn>
+    void visit_orders(Price price, Fn &&fn) const
+    {
+        if (!in_window(price))
+            return;
+        for (const Order &o : levels_[slot_of(price)])
+            if (!fn(o))
+                return;
+    }
+
+    // Mutating walk for fused matching: fn(Price, OrderList &) -> bool, best
+    // to worst; a level fn leaves empty is released before moving on
+    template <typename Fn>
+    void consume_levels(Fn &&fn)
+    {
+        for (size_t i = best_; i != NO_LEVEL;)
+        {
+            const bool more = fn(base_ + static_cast<Price>(i), levels_[i]);
+            const size_t next = next_live(i);
+            if (levels_[i].empty())
+                release_slot(i);
+            if (!more)
+                return;
+            i = next;
+        }
+    }
+
+    // ---- engine-facing mutators ----
+    // Orders at a refused price are not stored (the iterator is a null end())
+    void add_order(const Order &o) override;
+    OrderList::iterator add_order_and_get_iterator(const Order &o) override;
+    bool accepts_price(Price price) const override;
+
+    // Outside the window: an empty detached level, the window stays put
+    OrderList &get_orders_at_price(Price price) override;
+    const OrderList &get_orders_at_price(Price price) const override;
+
+    void remove_price_level(Price price) override;
+    bool empty_at_price(Price price) const override;
+
+    // ---- window management ----
+    // Move the window so it is centred on `center` (as far as live levels allow)
+    void recenter(Price center);
+    Price window_base() const { return base_; }
+    size_t window_ticks() const { return levels_.size(); }
+    size_t max_window_ticks() const { return max_ticks_; }
+
+    // ---- IEventListener ----
+    void on_event(const Event &e) override;
+
+private:
+    static constexpr Order::Side side_tag();
+    // true when a higher price is a better price (bids)
+    static constexpr bool HIGH_IS_BEST = Compare{}(Price{1}, Price{0});
+    static constexpr size_t NO_LEVEL = OccupancyBitmap::NPOS;
+
+    std::unique_ptr<OrderPool> owned_pool_; // only for standalone sides
+    OrderPool &pool_;                       // declared before levels: outlives them
+    size_t max_ticks_;                      // the window never grows past this
+    std::vector<PriceLevel> levels_;        // slot i holds price base_ + i
+    PriceLevel no_level_;                   // detached, always empty: lookups outside the window
+    OccupancyBitmap occupied_;       // slot i is a live level
+    Price base_ = 0;
+    size_t best_ = NO_LEVEL; // cached best slot
+    size_t count_ = 0;       // live levels
+
+    bool in_window(Price price) const
+    {
+        return price >= base_ && price < base_ + static_cast<Price>(levels_.size());
+    }
+    size_t slot_of(Price price) const { return static_cast<size_t>(price - base_); }
+    bool better(size_t a, size_t b) const { return HIGH_IS_BEST ? a > b : a < b; }
+
+    // Ticks spanned by the live levels and price together
+    size_t span_with(Price price) const;
+    // Slot for price, moving/growing the window if needed (NO_LEVEL: refused)
+    size_t ensure_slot(Price price);
+    void mark_live(size_t slot);
+    // Drop a live slot's level (clears its orders) and fix best_/count_
+    void release_slot(size_t slot);
+    // Next live slot after `from` towards worse prices
+    size_t next_live(size_t from) const
+    {
+        if constexpr (HIGH_IS_BEST)
+            return from == 0 ? NO_LEVEL : occupied_.find_prev(from - 1);
+        else
+            return occupied_.find_next(from + 1);
+    }
+    void rebase(Price new_base, size_t new_ticks);
+    std::vector<PriceLevel> make_levels(size_t ticks);
+};
+
+using BidLadderSide = LadderBookSide<utils::comparator::Descending>;
+using AskLadderSide = LadderBookSide<utils::comparator::Ascending>;
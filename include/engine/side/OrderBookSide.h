@@ -1,46 +1,100 @@
 #pragma once
+#include <iterator>
 #include <map>
-#include <list>
+#include <memory>
 #include <optional>
+#include <type_traits>
 #include <functional>
-#include "IOrderBookSideView.h"
+#include "IOrderBookSide.h"
 #include "utils/Comparator.h"
 #include "engine/events/IEventListener.h" // for Event + EventType
 
+// Sparse backend: one red-black tree node per live price level
 template <typename Compare>
-class OrderBookSide : public IOrderBookSideView, public IEventListener
+class OrderBookSide final : public IOrderBookSide
 {
 public:
-    using OrderList = std::list<Order>;
+    using OrderList = IOrderBookSide::OrderList;
     using PriceLevel = OrderList;
-    using PriceMap = std::map<double, PriceLevel, Compare>;
+
+    static constexpr SideBackend BACKEND =
+        std::is_same_v<Compare, utils::comparator::Descending> ? SideBackend::BidMap : SideBackend::AskMap;
+    using PriceMap = std::map<Price, PriceLevel, Compare>;
+
+    // Standalone side with its own pool, or a side drawing from a shared pool
+    OrderBookSide();
+    explicit OrderBookSide(OrderPool &pool);
 
     // ---- IOrderBookSideView ----
-    std::optional<double> best_price() const override;
+    std::optional<Price> best_price() const override;
+    std::optional<Price> next_price(Price price) const override;
     size_t num_levels() const override;
     void for_each_level(const std::function<void(const PriceLevelView &)> &fn) const override;
-    void for_each_order_at_price(double price, const std::function<void(const Order &)> &fn) const override;
+    void for_each_order_at_price(Price price, const std::function<void(const Order &)> &fn) const override;
+
+    // ---- static iteration (non-virtual, inlinable, early exit) ----
+    // fn(Price, const OrderList &) -> bool, best to worst; return false to stop
+    template <typename Fn>
+    void visit_levels(Fn &&fn) const
+    {
+        for (const auto &[price, orders] : price_levels_)
+            if (!fn(price, orders))
+                return;
+    }
+
+    // fn(const Order &) -> bool, FIFO within the level; return false to stop
+    template <typename Fn>
+    void visit_orders(Price price, Fn &&fn) const
+    {
+        auto it = price_levels_.find(price);
+        if (it == price_levels_.end())
+            return;
+        for (const Order &o : it->second)
+            if (!fn(o))
+                return;
+    }
+
+    // Mutating walk for fused matching: fn(Price, OrderList &) -> bool, best
+    // to worst; a level fn leaves empty is removed before moving on
+    template <typename Fn>
+    void consume_levels(Fn &&fn)
+    {
+        for (auto it = price_levels_.begin(); it != price_levels_.end();)
+        {
+            const bool more = fn(it->first, it->second);
+            it = it->second.empty() ? price_levels_.erase(it) : std::next(it);
+            if (!more)
+                return;
+        }
+    }
 
     // ---- engine-facing mutators ----
 
     // add an order
-    void add_order(const Order &o);
-    OrderList::iterator add_order_and_get_iterator(const Order &o);
+    void add_order(const Order &o) override;
+    OrderList::iterator add_order_and_get_iterator(const Order &o) override;
 
     // expose orders at price (non-const for engine use)
-    OrderList &get_orders_at_price(double price);
-    const OrderList &get_orders_at_price(double price) const;
+    OrderList &get_orders_at_price(Price price) override;
+    const OrderList &get_orders_at_price(Price price) const override;
 
-    void remove_price_level(double price);
-    bool empty_at_price(double price) const;
+    void remove_price_level(Price price) override;
+    bool empty_at_price(Price price) const override;
 
     // ---- IEventListener ----
     void on_event(const Event &e) override; // <-- exact signature
 
 private:
     static constexpr Order::Side side_tag(); // <-- static constexpr
+    std::unique_ptr<OrderPool> owned_pool_;  // only for standalone sides
+    OrderPool &pool_;                        // declared before levels: outlives them
     PriceMap price_levels_;
 
+    PriceLevel &level_at(Price price)
+    {
+        return price_levels_.try_emplace(price, pool_).first->second; // inserts if not exists
+    }
+
     // Event handles
     inline void handle_order_added(const E_OrderAdded &e);
     inline void handle_order_updated(const E_OrderUpdated &e);
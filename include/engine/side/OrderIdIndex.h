@@ -0,0 +1,229 @@
+#pragma once
+
+#include "engine/side/OrderPool.h"
+#include "utils/GeneralUtils.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// ---------------------------
+// Order id -> OrderHandle index for cancels and fills
+// - Open addressing over one flat array of 16-byte slots, Robin Hood
+//   probing (entries far from home displace entries close to home), so
+//   probe sequences stay short even at high load.
+// - Deletion shifts the following cluster back by one slot instead of
+//   leaving tombstones: lookups never wade through dead entries.
+// - Preallocated capacity (power of two); grows only past 7/8 load.
+// - DirectPerFeeder mode: ids built by utils::general::encode_order_id
+//   are (feeder << COUNTER_BITS | counter) with dense counters, so each
+//   feeder gets a direct-mapped window slot = counter & mask. A live
+//   order still holding the slot when the counter wraps the window
+//   spills the new id into the open-addressing table.
+
+enum class IdIndexMode
+{
+    OpenAddressing,
+    DirectPerFeeder
+};
+
+class OrderIdIndex
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY = size_t{1} << 17;
+    static constexpr size_t DEFAULT_FEEDER_WINDOW = size_t{1} << 16;
+
+    explicit OrderIdIndex(size_t capacity = DEFAULT_CAPACITY,
+                          IdIndexMode mode = IdIndexMode::OpenAddressing,
+                          size_t feeder_window = DEFAULT_FEEDER_WINDOW)
+        : mode_(mode), window_mask_(std::bit_ceil(feeder_window) - 1)
+    {
+        rehash(std::bit_ceil(std::max<size_t>(capacity, 16)));
+    }
+
+    // Insert or overwrite
+    void insert(uint64_t id, OrderHandle h)
+    {
+        if (mode_ == IdIndexMode::DirectPerFeeder)
+        {
+            DirectSlot &slot = direct_slot(id);
+            if (slot.handle == NULL_ORDER_HANDLE && table_size_ && table_find(id) != NPOS)
+            {
+                table_insert(id, h); // id already spilled: overwrite it there
+                return;
+            }
+            if (slot.handle == NULL_ORDER_HANDLE || slot.id == id)
+            {
+                if (slot.handle == NULL_ORDER_HANDLE)
+                    ++size_;
+                slot = DirectSlot{id, h};
+                return;
+            }
+            // window slot still held by an older live order: spill
+        }
+        table_insert(id, h);
+    }
+
+    // NULL_ORDER_HANDLE if absent
+    OrderHandle find(uint64_t id) const
+    {
+        if (mode_ == IdIndexMode::DirectPerFeeder)
+        {
+            if (const DirectSlot *slot = find_direct_slot(id); slot && slot->id == id && slot->handle != NULL_ORDER_HANDLE)
+                return slot->handle;
+        }
+        const size_t pos = table_find(id);
+        return pos == NPOS ? NULL_ORDER_HANDLE : slots_[pos].handle;
+    }
+
+    bool erase(uint64_t id)
+    {
+        if (mode_ == IdIndexMode::DirectPerFeeder)
+        {
+            if (DirectSlot *slot = find_direct_slot(id); slot && slot->id == id && slot->handle != NULL_ORDER_HANDLE)
+            {
+                slot->handle = NULL_ORDER_HANDLE;
+                --size_;
+                return true;
+            }
+        }
+        const size_t pos = table_find(id);
+        if (pos == NPOS)
+            return false;
+        table_erase_at(pos);
+        return true;
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return slots_.size(); }
+    IdIndexMode mode() const { return mode_; }
+
+private:
+    static constexpr size_t NPOS = static_cast<size_t>(-1);
+
+    struct Slot
+    {
+        uint64_t id;
+        OrderHandle handle;
+        uint32_t dist; // 0 = empty, else probe distance + 1
+    };
+
+    struct DirectSlot
+    {
+        uint64_t id;
+        OrderHandle handle = NULL_ORDER_HANDLE;
+    };
+
+    // ---- open addressing ----
+
+    size_t home(uint64_t id) const
+    {
+        // Fibonacci hashing: spreads sequential counters over the table
+        return static_cast<size_t>((id * 0x9E3779B97F4A7C15ull) >> shift_);
+    }
+
+    void rehash(size_t capacity)
+    {
+        std::vector<Slot> old = std::exchange(slots_, std::vector<Slot>(capacity, Slot{0, NULL_ORDER_HANDLE, 0}));
+        mask_ = capacity - 1;
+        shift_ = 64 - std::countr_zero(capacity);
+        table_size_ = 0;
+        for (const Slot &s : old)
+            if (s.dist)
+                table_insert(s.id, s.handle, /*count*/ false);
+    }
+
+    void table_insert(uint64_t id, OrderHandle h, bool count = true)
+    {
+        if ((table_size_ + 1) * 8 > slots_.size() * 7)
+            rehash(slots_.size() * 2); // cold path
+
+        Slot cur{id, h, 1};
+        for (size_t pos = home(id);; pos = (pos + 1) & mask_, ++cur.dist)
+        {
+            Slot &s = slots_[pos];
+            if (!s.dist)
+            {
+                s = cur;
+                ++table_size_;
+                if (count)
+                    ++size_;
+                return;
+            }
+            if (s.id == cur.id)
+            {
+                s.handle = cur.handle; // overwrite (only the original id can match)
+                return;
+            }
+            if (s.dist < cur.dist)
+                std::swap(s, cur); // rich entry yields its slot, keep placing it
+        }
+    }
+
+    size_t table_find(uint64_t id) const
+    {
+        uint32_t dist = 1;
+        for (size_t pos = home(id);; pos = (pos + 1) & mask_, ++dist)
+        {
+            const Slot &s = slots_[pos];
+            // Robin Hood invariant: once we are further from home than the
+            // resident entry, the id cannot be further along
+            if (s.dist < dist)
+                return NPOS;
+            if (s.id == id)
+                return pos;
+        }
+    }
+
+    void table_erase_at(size_t pos)
+    {
+        // backward-shift deletion: pull the rest of the cluster one slot closer to home
+        for (size_t next = (pos + 1) & mask_; slots_[next].dist > 1; pos = next, next = (next + 1) & mask_)
+        {
+            slots_[pos] = slots_[next];
+            --slots_[pos].dist;
+        }
+        slots_[pos].dist = 0;
+        --table_size_;
+        --size_;
+    }
+
+    // ---- direct-mapped per feeder ----
+
+    DirectSlot &direct_slot(uint64_t id)
+    {
+        const size_t feeder = static_cast<size_t>(id >> utils::general::COUNTER_BITS);
+        if (feeder >= windows_.size())
+            windows_.resize(feeder + 1);
+        auto &window = windows_[feeder];
+        if (window.empty())
+            window.resize(window_mask_ + 1); // first order from this feeder (cold)
+        return window[id & window_mask_];
+    }
+
+    const DirectSlot *find_direct_slot(uint64_t id) const
+    {
+        const size_t feeder = static_cast<size_t>(id >> utils::general::COUNTER_BITS);
+        if (feeder >= windows_.size() || windows_[feeder].empty())
+            return nullptr;
+        return &windows_[feeder][id & window_mask_];
+    }
+
+    DirectSlot *find_direct_slot(uint64_t id)
+    {
+        return const_cast<DirectSlot *>(std::as_const(*this).find_direct_slot(id));
+    }
+
+    IdIndexMode mode_;
+    std::vector<Slot> slots_;
+    size_t mask_ = 0;
+    int shift_ = 0;
+    size_t table_size_ = 0; // entries in slots_
+    size_t size_ = 0;       // entries overall
+
+    size_t window_mask_;
+    std::vector<std::vector<DirectSlot>> windows_; // indexed by feeder id
+};
@@ -0,0 +1,254 @@
+#pragma once
+
+#include "core/Order.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// ---------------------------
+// Pooled, intrusive storage for resting orders
+// - OrderPool is a slab allocator of 64-byte Order nodes addressed by a
+//   32-bit handle. Slabs are allocated up front (configurable capacity),
+//   so adding/filling/cancelling orders never calls malloc/free.
+//   If the capacity is exceeded one more slab is added (cold path).
+// - Free nodes are chained through Order::poolNext. A fresh pool hands
+//   nodes out in address order, so orders queued together sit in adjacent
+//   cache lines and FIFO walks stream through memory.
+// - OrderQueue is one price level: a doubly linked FIFO threaded through
+//   Order::poolPrev/poolNext. It mimics the std::list subset the book uses.
+// - Each OrderQueue also carries its order count and aggregate quantity,
+//   updated on push/erase/reduce, so level totals never need a re-sum.
+//   Resting quantities must only change through OrderQueue::reduce.
+
+using OrderHandle = uint32_t;
+inline constexpr OrderHandle NULL_ORDER_HANDLE = static_cast<OrderHandle>(-1);
+
+class OrderPool
+{
+public:
+    static constexpr size_t SLAB_SHIFT = 12; // 4096 nodes (256 KB) per slab
+    static constexpr size_t SLAB_SIZE = size_t{1} << SLAB_SHIFT;
+    static constexpr size_t SLAB_MASK = SLAB_SIZE - 1;
+    static constexpr size_t DEFAULT_CAPACITY = size_t{1} << 14;
+
+    explicit OrderPool(size_t capacity = DEFAULT_CAPACITY)
+    {
+        while (slabs_.size() * SLAB_SIZE < capacity)
+            add_slab();
+    }
+
+    OrderPool(const OrderPool &) = delete;
+    OrderPool &operator=(const OrderPool &) = delete;
+
+    // Copy `o` into a free node and return its handle
+    OrderHandle allocate(const Order &o)
+    {
+        if (free_head_ == NULL_ORDER_HANDLE)
+            add_slab();
+        const OrderHandle h = free_head_;
+        Order &node = (*this)[h];
+        free_head_ = node.poolNext;
+        node = o;
+        ++in_use_;
+        return h;
+    }
+
+    void release(OrderHandle h)
+    {
+        (*this)[h].poolNext = free_head_;
+        free_head_ = h;
+        --in_use_;
+    }
+
+    Order &operator[](OrderHandle h) { return slabs_[h >> SLAB_SHIFT][h & SLAB_MASK]; }
+    const Order &operator[](OrderHandle h) const { return slabs_[h >> SLAB_SHIFT][h & SLAB_MASK]; }
+
+    size_t capacity() const { return slabs_.size() * SLAB_SIZE; }
+    size_t in_use() const { return in_use_; }
+
+private:
+    void add_slab()
+    {
+        const OrderHandle first = static_cast<OrderHandle>(slabs_.size() * SLAB_SIZE);
+        slabs_.push_back(std::make_unique<Order[]>(SLAB_SIZE));
+        Order *slab = slabs_.back().get();
+        // chain the new nodes in address order in front of the free list
+        for (size_t i = 0; i < SLAB_SIZE; ++i)
+            slab[i].poolNext = (i + 1 < SLAB_SIZE) ? first + static_cast<OrderHandle>(i + 1) : free_head_;
+        free_head_ = first;
+    }
+
+    std::vector<std::unique_ptr<Order[]>> slabs_;
+    OrderHandle free_head_ = NULL_ORDER_HANDLE;
+    size_t in_use_ = 0;
+};
+
+template <bool Const>
+class OrderQueueIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Order;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const Order *, Order *>;
+    using reference = std::conditional_t<Const, const Order &, Order &>;
+    using PoolPtr = std::conditional_t<Const, const OrderPool *, OrderPool *>;
+
+    OrderQueueIterator() = default;
+    OrderQueueIterator(PoolPtr pool, OrderHandle h) : pool_(pool), handle_(h) {}
+
+    // iterator -> const_iterator
+    operator OrderQueueIterator<true>() const { return {pool_, handle_}; }
+
+    reference operator*() const { return (*pool_)[handle_]; }
+    pointer operator->() const { return &(*pool_)[handle_]; }
+
+    OrderQueueIterator &operator++()
+    {
+        handle_ = (*pool_)[handle_].poolNext;
+        return *this;
+    }
+    OrderQueueIterator operator++(int)
+    {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(const OrderQueueIterator &o) const { return handle_ == o.handle_; }
+
+    OrderHandle handle() const { return handle_; }
+
+private:
+    PoolPtr pool_ = nullptr;
+    OrderHandle handle_ = NULL_ORDER_HANDLE;
+};
+
+class OrderQueue
+{
+public:
+    using iterator = OrderQueueIterator<false>;
+    using const_iterator = OrderQueueIterator<true>;
+
+    OrderQueue() = default; // detached, always empty (e.g. "no level" sentinels)
+    explicit OrderQueue(OrderPool &pool) : pool_(&pool) {}
+
+    OrderQueue(const OrderQueue &) = delete;
+    OrderQueue &operator=(const OrderQueue &) = delete;
+
+    // Moving a level keeps its nodes (and handles/iterators into it) valid
+    OrderQueue(OrderQueue &&o) noexcept
+        : pool_(o.pool_), head_(o.head_), tail_(o.tail_), size_(o.size_), aggregate_qty_(o.aggregate_qty_)
+    {
+        o.detach();
+    }
+    OrderQueue &operator=(OrderQueue &&o) noexcept
+    {
+        if (this != &o)
+        {
+            clear();
+            pool_ = o.pool_;
+            head_ = o.head_;
+            tail_ = o.tail_;
+            size_ = o.size_;
+            aggregate_qty_ = o.aggregate_qty_;
+            o.detach();
+        }
+        return *this;
+    }
+
+    ~OrderQueue() { clear(); }
+
+    iterator push_back(const Order &o)
+    {
+        const OrderHandle h = pool_->allocate(o);
+        Order &node = (*pool_)[h];
+        node.poolPrev = tail_;
+        node.poolNext = NULL_ORDER_HANDLE;
+        if (tail_ != NULL_ORDER_HANDLE)
+            (*pool_)[tail_].poolNext = h;
+        else
+            head_ = h;
+        tail_ = h;
+        ++size_;
+        aggregate_qty_ += node.quantity;
+        return iterator{pool_, h};
+    }
+
+    // Unlink and free the node, return the iterator after it
+    iterator erase(const_iterator it)
+    {
+        const OrderHandle h = it.handle();
+        Order &node = (*pool_)[h];
+        const OrderHandle prev = node.poolPrev;
+        const OrderHandle next = node.poolNext;
+        if (prev != NULL_ORDER_HANDLE)
+            (*pool_)[prev].poolNext = next;
+        else
+            head_ = next;
+        if (next != NULL_ORDER_HANDLE)
+            (*pool_)[next].poolPrev = prev;
+        else
+            tail_ = prev;
+        aggregate_qty_ -= node.quantity;
+        pool_->release(h);
+        --size_;
+        return iterator{pool_, next};
+    }
+
+    void clear()
+    {
+        for (OrderHandle h = head_; h != NULL_ORDER_HANDLE;)
+        {
+            const OrderHandle next = (*pool_)[h].poolNext;
+            pool_->release(h);
+            h = next;
+        }
+        head_ = tail_ = NULL_ORDER_HANDLE;
+        size_ = 0;
+        aggregate_qty_ = 0;
+    }
+
+    // Reduce a resting order's quantity (clamped at zero), keeping the
+    // level aggregate in step. Returns the order's remaining quantity.
+    uint32_t reduce(iterator it, uint32_t qty)
+    {
+        Order &node = *it;
+        const uint32_t taken = qty >= node.quantity ? node.quantity : qty;
+        node.quantity -= taken;
+        aggregate_qty_ -= taken;
+        return node.quantity;
+    }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; } // order count
+    uint64_t aggregate_qty() const { return aggregate_qty_; }
+
+    Order &front() { return (*pool_)[head_]; }
+    const Order &front() const { return (*pool_)[head_]; }
+    Order &back() { return (*pool_)[tail_]; }
+    const Order &back() const { return (*pool_)[tail_]; }
+
+    iterator begin() { return {pool_, head_}; }
+    iterator end() { return {pool_, NULL_ORDER_HANDLE}; }
+    const_iterator begin() const { return {pool_, head_}; }
+    const_iterator end() const { return {pool_, NULL_ORDER_HANDLE}; }
+
+private:
+    void detach()
+    {
+        head_ = tail_ = NULL_ORDER_HANDLE;
+        size_ = 0;
+        aggregate_qty_ = 0;
+    }
+
+    OrderPool *pool_ = nullptr;
+    OrderHandle head_ = NULL_ORDER_HANDLE;
+    OrderHandle tail_ = NULL_ORDER_HANDLE;
+    size_t size_ = 0;
+    uint64_t aggregate_qty_ = 0; // sum of resting quantities, kept in O(1)
+};
@@ -1,4 +1,6 @@
 #pragma once
+#include "core/Price.h"
+
 #include <cstdint>
 
 /**
@@ -7,9 +9,9 @@
  */
 struct PriceLevelView
 {
-    double price;
-    size_t order_count;
-    uint32_t aggregate_qty; // new: total qty at this level
+    Price price; // ticks
+    size_t order_count;     // resting orders at this level
+    uint64_t aggregate_qty; // total qty at this level
     // // optional optimization
     // template <typename Fn>
     // void for_each_level(Fn &&fn) const;
@@ -24,7 +26,7 @@ struct std::formatter<PriceLevelView> : std::formatter<std::string>
     {
         return std::formatter<std::string>::format(
             std::format("Price:{:.2f} order_count:{} aggregate_qty:{}",
-                        p.price,
+                        DEFAULT_INSTRUMENT.to_price(p.price),
                         p.order_count,
                         p.aggregate_qty),
             ctx);
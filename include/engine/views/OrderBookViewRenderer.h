@@ -27,12 +27,12 @@ public:
         for (size_t i = 0; i < max_rows; ++i)
         {
             if (i < bids.size())
-                os << std::format("BID {:6} @ {:.2f}", bids[i].aggregate_qty, bids[i].price);
+                os << std::format("BID {:6} @ {:.2f}", bids[i].aggregate_qty, DEFAULT_INSTRUMENT.to_price(bids[i].price));
             else
                 os << "                     ";
 
             if (i < asks.size())
-                os << std::format("   ASK {:6} @ {:.2f}", asks[i].aggregate_qty, asks[i].price);
+                os << std::format("   ASK {:6} @ {:.2f}", asks[i].aggregate_qty, DEFAULT_INSTRUMENT.to_price(asks[i].price));
 
             os << "\n";
             line_count++;
@@ -22,9 +22,9 @@ public:
         os << std::format("Total Cancels: {}\n", stats_->total_cancels());
 
         if (auto bid = stats_->last_best_bid())
-            os << std::format("Best Bid:    {}\n", *bid);
+            os << std::format("Best Bid:    {:.2f}\n", DEFAULT_INSTRUMENT.to_price(*bid));
         if (auto ask = stats_->last_best_ask())
-            os << std::format("Best Ask:    {}\n", *ask);
+            os << std::format("Best Ask:    {:.2f}\n", DEFAULT_INSTRUMENT.to_price(*ask));
 
         os << std::format("Trade Count: {} | Avg Spread: {:.2f}\n",
                           stats_->trade_count(),
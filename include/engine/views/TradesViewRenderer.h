@@ -4,27 +4,28 @@
 
 #include <deque>
 #include <format>
+#include <iterator>
 #include <memory>
 #include <ostream>
-#include <span>
 
 class TradesViewRenderer : public IView {
 public:
-  using WallTime = uint32_t;
-
-  explicit TradesViewRenderer(std::shared_ptr<TradeBuffer> buffer, std::span<const WallTime> tick_times, size_t n = 5)
-    : buffer_(std::move(buffer)), tick_times_(tick_times), N_(n) {}
+  explicit TradesViewRenderer(std::shared_ptr<TradeBuffer> buffer, size_t n = 5)
+    : buffer_(std::move(buffer)), N_(n) {}
 
   size_t render(std::ostream &os) override
   {
-    // Drain new trades from buffer_
-    TradeInfo t;
-    while (buffer_->pop(t))
+    // Drain new trades from buffer_ a batch at a time
+    TradeInfo batch[64];
+    while (size_t n = buffer_->pop_n(batch, std::size(batch)))
     {
-      recent_.push_back(std::move(t));
-      if (recent_.size() > N_)
+      for (size_t i = 0; i < n; ++i)
       {
-        recent_.pop_front(); // keep only last N
+        recent_.push_back(std::move(batch[i]));
+        if (recent_.size() > N_)
+        {
+          recent_.pop_front(); // keep only last N
+        }
       }
     }
 
@@ -34,14 +35,13 @@ public:
     os << "=== Trades View (last " << N_ << ") ===\n";
     for (auto &trade : recent_)
     {
-      os << std::format("{} Timestamp:{}\n", trade, tick_times_[trade.ts]);
+      os << std::format("{}\n", trade); // trade.ts is the engine time in ns
     }
     return recent_.size();
   }
 
 private:
   std::shared_ptr<TradeBuffer> buffer_;
-  std::span<const WallTime> tick_times_; // store span of wall times
   std::deque<TradeInfo> recent_;         // rolling window of last N trades
   size_t N_;
 };
@@ -1,9 +1,9 @@
 // MarketSimulator.h
 #pragma once
 
-#include "utils/data_structures/ThreadSafeQueue.h"
 #include "core/MarketFeeder.h"
 #include "engine/OrderBookEngine.h"
+#include "utils/concurrency/WaitStrategy.h"
 #include "utils/random/IRNG.h"
 #include "engine/listeners/OrderBookView.h"
 #include "engine/listeners/StatsCollector.h"
@@ -16,7 +16,9 @@
 class MarketSimulator
 {
 public:
-    MarketSimulator();
+    // BusySpin for latency runs on dedicated cores; SpinPark idles cheaply on shared machines
+    explicit MarketSimulator(WaitStrategy engine_wait = WaitStrategy::SpinPark);
+    ~MarketSimulator();
     void start();
     void stop();
 
@@ -25,13 +27,18 @@ public:
     size_t add_listener(EventBus::Callback cb);
 
 private:
+    static constexpr size_t ENGINE_BATCH_SIZE = 256;         // max orders per engine batch
+    static constexpr size_t LANE_CAPACITY = size_t{1} << 14;    // orders in flight per feeder lane
+
+    static unsigned int feeder_count();
     void engine_loop();
 
-    ThreadSafeQueue<Order> order_queue_;
+    OrderIngress ingress_; // one SPSC lane per feeder, merged by timestamp
+    WaitStrategy engine_wait_;
     std::atomic<bool> running_{false};
 
     EventBus bus_;           // central event dispatcher
-    OrderBookEngine engine_; // engine now subscribes to EventBus
+    PriceTimeLadderEngine engine_; // statically dispatched engine, subscribes to EventBus
 
     // Event-driven live view components
     std::shared_ptr<MarketDataPublisher> publisher_;
@@ -43,11 +50,12 @@ private:
     template <typename ListenerType, typename... Args>
     std::shared_ptr<ListenerType> make_and_add_listener_to_bus(
         std::vector<std::pair<std::shared_ptr<void>, size_t>> &container,
+        ListenerOptions opts,
         Args &&...args)
     {
         auto listener = std::make_shared<ListenerType>(std::forward<Args>(args)...);
-        size_t id = bus_.add_listener([listener](const Event &e)
-                                      { listener->on_event(e); });
+        opts.mask = ListenerType::EVENT_MASK;
+        size_t id = bus_.add_listener(listener, opts); // typed: on_event called directly
         container.emplace_back(listener, id);
         return listener;
     }
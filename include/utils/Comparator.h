@@ -1,13 +1,17 @@
+#pragma once
+
+#include "core/Price.h"
+
 namespace utils::comparator
 {
     // Define comparator type alias for bids and asks
     struct Descending
     {
-        bool operator()(double a, double b) const { return a > b; }
+        constexpr bool operator()(Price a, Price b) const { return a > b; }
     };
 
     struct Ascending
     {
-        bool operator()(double a, double b) const { return a < b; }
+        constexpr bool operator()(Price a, Price b) const { return a < b; }
     };
 }
@@ -1,3 +1,6 @@
+#pragma once
+
+#include <cstdint>
 #include <memory>
 
 namespace utils::general
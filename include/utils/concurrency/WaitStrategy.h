@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// ---------------------------
+// Idle handling for polling consumer threads
+// - BusySpin never gives up the core: lowest wakeup latency, burns a core
+//   even when idle (pinned production boxes).
+// - SpinYield spins briefly, then yields between polls.
+// - SpinPark spins, yields, then sleeps on a Doorbell (futex-backed
+//   std::atomic::wait) until a producer rings it: near-zero idle CPU, one
+//   syscall per wakeup (dev laptops, oversubscribed CI).
+// A Doorbell costs producers a fence and a load while nobody interested is parked.
+
+enum class WaitStrategy : uint8_t
+{
+    BusySpin,
+    SpinYield,
+    SpinPark,
+};
+
+inline void cpu_relax() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/**
+ * @brief Futex-style wakeup channel between producers and parked consumers.
+ *
+ * Consumers park with an interest mask and producers ring with the mask of
+ * what they published: a consumer is only woken for work it wants.
+ */
+class Doorbell
+{
+public:
+    static constexpr uint32_t ANY = ~uint32_t{0};
+
+    // Producer: call after publishing work. Only pays for a notify (syscall)
+    // when a consumer interested in `what` is parked.
+    void ring(uint32_t what = ANY) noexcept
+    {
+        // pairs with the fence in park(): either the parked consumer sees our
+        // work in ready(), or we see its interest
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (interest_.load(std::memory_order_relaxed) & what)
+            wake_all();
+    }
+
+    // Unconditional wakeup (shutdown, configuration changes)
+    void wake_all() noexcept
+    {
+        // Every sleeper wakes and re-registers its interest if it parks again.
+        // A bit left by a park that never slept only costs one extra wakeup.
+        interest_.store(0, std::memory_order_relaxed);
+        epoch_.fetch_add(1, std::memory_order_release);
+        epoch_.notify_all();
+    }
+
+    // Consumer: sleep until rung for `interest`, unless ready() already holds.
+    // Returns whether it actually went to sleep.
+    template <typename Ready>
+    bool park(Ready &&ready, uint32_t interest = ANY)
+    {
+        const uint32_t epoch = epoch_.load(std::memory_order_acquire);
+        interest_.fetch_or(interest, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const bool sleep = !ready();
+        if (sleep)
+        {
+            sleepers_.fetch_add(1, std::memory_order_relaxed);
+            epoch_.wait(epoch, std::memory_order_acquire); // returns at once if rung since the load
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return sleep;
+    }
+
+    // Consumers committed to sleeping (observability and tests): once counted,
+    // a consumer only returns from park() through a ring
+    uint32_t sleepers() const noexcept { return sleepers_.load(std::memory_order_relaxed); }
+
+private:
+    alignas(64) std::atomic<uint32_t> epoch_{0};
+    std::atomic<uint32_t> interest_{0}; // union of parked consumers' interests
+    std::atomic<uint32_t> sleepers_{0};
+};
+
+/**
+ * @brief Per-thread escalation state: call idle() on every empty poll and
+ * reset() whenever the poll found work.
+ */
+class IdleWaiter
+{
+public:
+    static constexpr uint32_t DEFAULT_SPINS = 1u << 10;
+    static constexpr uint32_t DEFAULT_YIELDS = 1u << 6;
+
+    explicit IdleWaiter(WaitStrategy strategy, Doorbell *bell = nullptr,
+                        uint32_t spins = DEFAULT_SPINS, uint32_t yields = DEFAULT_YIELDS)
+        : strategy_(bell || strategy != WaitStrategy::SpinPark ? strategy : WaitStrategy::SpinYield),
+          bell_(bell), spins_(spins), yields_(yields) {}
+
+    WaitStrategy strategy() const { return strategy_; }
+
+    void reset() { idle_polls_ = 0; }
+
+    // ready() is rechecked before sleeping; it must also turn true on shutdown.
+    // Returns true when this call parked (and has now been woken).
+    template <typename Ready>
+    bool idle(Ready &&ready, uint32_t interest = Doorbell::ANY)
+    {
+        if (strategy_ == WaitStrategy::BusySpin || idle_polls_ < spins_)
+        {
+            ++idle_polls_;
+            cpu_relax();
+            return false;
+        }
+        if (strategy_ == WaitStrategy::SpinYield || idle_polls_ < spins_ + yields_)
+        {
+            ++idle_polls_;
+            std::this_thread::yield();
+            return false;
+        }
+        idle_polls_ = 0;
+        return bell_->park(ready, interest);
+    }
+
+private:
+    WaitStrategy strategy_; // SpinPark without a doorbell degrades to SpinYield
+    Doorbell *bell_;
+    uint32_t spins_;
+    uint32_t yields_;
+    uint32_t idle_polls_ = 0;
+};
@@ -0,0 +1,196 @@
+// ConflatingMap.h
+#pragma once
+#include "utils/data_structures/spsc.h"
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+// ---------------------------
+// Single-producer, single-consumer "latest value per key" table
+// - put(k, v) overwrites the key's value in place; the key is queued for the
+//   consumer only on its clean -> dirty transition. A lagging consumer thus
+//   costs one queue entry per key, never one per update, and memory stays
+//   fixed however fast the producer runs.
+// - drain() hands the consumer the newest value of every key updated since
+//   it last looked. A key updated mid-drain may be delivered twice (with its
+//   newest value last), never stale.
+// - Values are published through a per-slot seqlock (T trivially copyable).
+// - capacity bounds the number of live keys: put() returns false for a new
+//   key once the table is full. put(k, v, true) retires the key: once the
+//   consumer has delivered that value (and no newer put superseded it) the
+//   slot goes back to the producer, handed over through a second SPSC queue.
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class ConflatingMap
+{
+public:
+    explicit ConflatingMap(size_t capacity)
+        : mask_(std::bit_ceil(capacity * 2) - 1), // load factor <= 1/2
+          slots_(std::make_unique<Slot[]>(mask_ + 1)),
+          dirty_(mask_ + 1),
+          freed_(mask_ + 1), // at most one pending hand-back per slot
+          capacity_(capacity)
+    {
+    }
+
+    size_t capacity() const { return capacity_; }
+    size_t size() const { return size_; } // producer-side view
+
+    // ---- producer ----
+
+    // retire: this is the key's last value (e.g. a level going to zero)
+    bool put(const Key &key, const Value &value, bool retire = false)
+    {
+        reclaim();
+        const size_t i = find_or_insert(key);
+        if (i == NPOS)
+            return false;
+
+        Slot &s = slots_[i];
+        const uint32_t v = s.version.load(std::memory_order_relaxed);
+        s.version.store(v + 1, std::memory_order_relaxed); // odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        s.value = value;
+        s.retire = retire;
+        s.version.store(v + 2, std::memory_order_release);
+        puts_.fetch_add(1, std::memory_order_relaxed);
+
+        if (!s.dirty.exchange(true, std::memory_order_acq_rel))
+            dirty_.push(static_cast<uint32_t>(i)); // at most once per slot: never full
+        return true;
+    }
+
+    // ---- consumer ----
+
+    // fn(const Key &, const Value &) for every key updated since the last drain
+    template <typename Fn>
+    size_t drain(Fn &&fn, size_t max_items = SIZE_MAX)
+    {
+        size_t n = 0;
+        uint32_t i;
+        while (n < max_items && dirty_.pop(i))
+        {
+            Slot &s = slots_[i];
+            // clear before reading: an update racing us re-queues the key. An RMW,
+            // so it synchronises with the producer's latest exchange and the
+            // read below sees at least that update.
+            s.dirty.exchange(false, std::memory_order_acq_rel);
+            Value value;
+            bool retire;
+            uint32_t before, after;
+            do
+            {
+                before = s.version.load(std::memory_order_acquire);
+                value = s.value;
+                retire = s.retire;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                after = s.version.load(std::memory_order_relaxed);
+            } while (before != after || (before & 1));
+            fn(s.key, value);
+            ++n;
+            // Hand the slot back only once nothing for it is queued (a put racing
+            // the read above re-queued it: free it on that delivery instead), and
+            // only after fn, as the producer may rewrite the key once it sees it.
+            // A full freed_ just leaves the slot in use.
+            if (retire && !s.dirty.load(std::memory_order_acquire))
+                freed_.push(Freed{i, before});
+        }
+        delivered_.fetch_add(n, std::memory_order_relaxed);
+        return n;
+    }
+
+    // Updates not delivered one-for-one: merged into a newer value (or still pending)
+    uint64_t conflated() const
+    {
+        const uint64_t puts = puts_.load(std::memory_order_relaxed);
+        const uint64_t delivered = delivered_.load(std::memory_order_relaxed);
+        return puts > delivered ? puts - delivered : 0;
+    }
+
+private:
+    static constexpr size_t NPOS = SIZE_MAX;
+
+    enum class State : uint8_t
+    {
+        Empty,
+        Live,
+        Tombstone // freed, but probe chains still run through it
+    };
+
+    struct Slot
+    {
+        Key key{};
+        State state = State::Empty; // producer-only
+        std::atomic<uint32_t> version{0};
+        std::atomic<bool> dirty{false};
+        bool retire = false; // written under the seqlock, with value
+        Value value{};
+    };
+
+    // A delivered retiring value: slot index and the seqlock version it had
+    struct Freed
+    {
+        uint32_t slot;
+        uint32_t version;
+    };
+
+    size_t find_or_insert(const Key &key)
+    {
+        size_t i = Hash{}(key) & mask_;
+        size_t tombstone = NPOS;
+        for (size_t probes = 0; probes <= mask_ && slots_[i].state != State::Empty; ++probes)
+        {
+            if (slots_[i].state == State::Live && slots_[i].key == key)
+                return i;
+            if (slots_[i].state == State::Tombstone && tombstone == NPOS)
+                tombstone = i;
+            i = (i + 1) & mask_;
+        }
+        if (size_ == capacity_)
+            return NPOS;
+        if (tombstone != NPOS)
+            i = tombstone; // live keys < slots: a full probe always passes one
+        slots_[i].key = key; // published to the consumer by the dirty queue push
+        slots_[i].state = State::Live;
+        ++size_;
+        return i;
+    }
+
+    // Take back slots whose retiring value the consumer has delivered. A slot
+    // put to since then (version moved on) stays live: that key is back.
+    void reclaim()
+    {
+        Freed f;
+        while (freed_.pop(f))
+        {
+            Slot &s = slots_[f.slot];
+            if (s.state != State::Live || s.version.load(std::memory_order_relaxed) != f.version)
+                continue;
+            --size_;
+            if (slots_[(f.slot + 1) & mask_].state != State::Empty)
+            {
+                s.state = State::Tombstone;
+                continue;
+            }
+            // End of a probe chain: empty it, and the tombstones leading up to it
+            size_t i = f.slot;
+            do
+            {
+                slots_[i].state = State::Empty;
+                i = (i - 1) & mask_;
+            } while (slots_[i].state == State::Tombstone);
+        }
+    }
+
+    size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    SPSC<uint32_t> dirty_; // slot indices with an undelivered update
+    SPSC<Freed> freed_;    // consumer -> producer: retired slots to take back
+    size_t capacity_;
+    size_t size_ = 0;
+    std::atomic<uint64_t> puts_{0};
+    std::atomic<uint64_t> delivered_{0};
+};
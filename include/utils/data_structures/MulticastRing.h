@@ -0,0 +1,248 @@
+// MulticastRing.h
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+// ---------------------------
+// Single-producer, multi-consumer broadcast ring (Disruptor style)
+// - One shared ring: the producer writes every item once, whatever the
+//   number of consumers. Each consumer owns a Cursor (next sequence to read).
+// - Gating consumers are never overrun: the producer only claims slots once
+//   the slowest gating cursor has moved past them. The gate is cached, so the
+//   cursors are only scanned when the cached gate says the ring is full.
+// - Non-gating consumers can be lapped: a per-slot sequence stamp (seqlock)
+//   detects a slot overwritten under the reader, which then skips ahead to
+//   the oldest item still in the ring and counts the loss in `dropped`.
+// - Values and stamps live in separate arrays so ready items are contiguous:
+//   poll_batch hands gating consumers zero-copy spans straight into the ring
+//   and acknowledges a whole batch with one cursor store.
+// - T must be trivially copyable (readers may copy a slot mid-overwrite and
+//   discard it).
+// - Cursors live in a fixed table of MAX_CURSORS (never reallocated), so
+//   subscribe/unsubscribe may run while the producer publishes. Callers
+//   serialise them among themselves. An unsubscribed cursor's slot is reused.
+
+template <typename T>
+class MulticastRing
+{
+public:
+    static constexpr size_t MAX_CURSORS = 64; // subscribed at once
+
+    struct alignas(64) Cursor
+    {
+        std::atomic<uint64_t> next{0};    // next sequence to read (written by its consumer)
+        std::atomic<uint64_t> dropped{0}; // items lost to lapping (non-gating only)
+        std::atomic<bool> gating{false};
+        std::atomic<bool> active{false};
+    };
+
+    explicit MulticastRing(size_t cap_pow2)
+        : mask_(cap_pow2 - 1),
+          values_(std::make_unique<T[]>(cap_pow2)),
+          stamps_(std::make_unique<std::atomic<uint64_t>[]>(cap_pow2)),
+          cursors_(std::make_unique<Cursor[]>(MAX_CURSORS))
+    {
+        // cap must be power of two
+        for (size_t i = 0; i < cap_pow2; ++i)
+            stamps_[i].store(EMPTY, std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+    // ---- control (any thread, one at a time) ----
+
+    // New consumer, starting at the next item published
+    Cursor *subscribe(bool gating)
+    {
+        const size_t n = count_.load(std::memory_order_relaxed);
+        size_t i = 0;
+        while (i < n && cursors_[i].active.load(std::memory_order_relaxed))
+            ++i;
+        assert(i < MAX_CURSORS && "MulticastRing: too many cursors");
+
+        Cursor &c = cursors_[i];
+        // Gate from the oldest slot still in the ring until the real start is
+        // known (min_gating clamps it there): the producer may stall for a
+        // moment, never overrun it.
+        c.next.store(0, std::memory_order_relaxed);
+        c.dropped.store(0, std::memory_order_relaxed);
+        c.gating.store(gating, std::memory_order_relaxed);
+        c.active.store(true, std::memory_order_release);
+        if (i == n)
+            count_.store(n + 1, std::memory_order_release);
+        // Pairs with the fence in min_gating: either the producer's next scan
+        // sees this cursor, or the head read here covers everything it wrote
+        // under a gate that ignored it
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        c.next.store(head_.load(std::memory_order_relaxed), std::memory_order_release);
+        return &c;
+    }
+
+    void unsubscribe(Cursor *c)
+    {
+        c->active.store(false, std::memory_order_release); // stops gating; the slot can be reused
+    }
+
+    // ---- producer ----
+
+    // Slots the producer can write right now without overrunning a gating consumer
+    size_t free_slots()
+    {
+        const uint64_t h = head_.load(std::memory_order_relaxed);
+        if (h - gate_cache_ >= capacity())
+            gate_cache_ = min_gating(h); // only scan the cursors when the cache says full
+        return capacity() - static_cast<size_t>(h - gate_cache_);
+    }
+
+    // Write n <= free_slots() items and publish them with one release store
+    void write(const T *items, size_t n)
+    {
+        const uint64_t h = head_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < n; ++i)
+        {
+            const size_t idx = (h + i) & mask_;
+            stamps_[idx].store(BUSY, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            values_[idx] = items[i];
+            stamps_[idx].store(h + i, std::memory_order_release);
+        }
+        head_.store(h + n, std::memory_order_release);
+    }
+
+    // ---- consumer ----
+
+    // Deliver up to max_items to fn(const T &) in order; returns the number delivered
+    template <typename Fn>
+    size_t poll(Cursor &c, Fn &&fn, size_t max_items = SIZE_MAX)
+    {
+        uint64_t seq = c.next.load(std::memory_order_relaxed);
+        const uint64_t avail = head_.load(std::memory_order_acquire);
+        size_t delivered = 0;
+        T item;
+        while (seq < avail && delivered < max_items)
+        {
+            if (!read(seq, item))
+            {
+                // lapped: jump to the oldest item still in the ring
+                const uint64_t oldest = head_.load(std::memory_order_acquire) - capacity();
+                c.dropped.fetch_add(oldest - seq, std::memory_order_relaxed);
+                seq = oldest;
+                continue;
+            }
+            fn(item);
+            ++seq;
+            ++delivered;
+        }
+        c.next.store(seq, std::memory_order_release);
+        return delivered;
+    }
+
+    // Deliver up to max_items to fn(std::span<const T>) as contiguous runs (at
+    // most two per call for gating cursors: the ring may wrap) and advance the
+    // cursor once. Gating cursors see the ring's own storage: the producer
+    // cannot reuse those slots until the cursor moves, so the span stays valid
+    // for the duration of fn. Non-gating cursors can be lapped mid-read and get
+    // validated copies instead, COPY_CHUNK items at a time.
+    template <typename Fn>
+    size_t poll_batch(Cursor &c, Fn &&fn, size_t max_items = SIZE_MAX)
+    {
+        uint64_t seq = c.next.load(std::memory_order_relaxed);
+        const uint64_t avail = head_.load(std::memory_order_acquire);
+        size_t delivered = 0;
+        if (c.gating.load(std::memory_order_relaxed))
+        {
+            while (seq < avail && delivered < max_items)
+            {
+                const size_t idx = seq & mask_;
+                const size_t n = std::min({static_cast<size_t>(avail - seq), capacity() - idx, max_items - delivered});
+                fn(std::span<const T>(values_.get() + idx, n));
+                seq += n;
+                delivered += n;
+            }
+        }
+        else
+        {
+            T buf[COPY_CHUNK];
+            while (seq < avail && delivered < max_items)
+            {
+                const size_t n = std::min({static_cast<size_t>(avail - seq), COPY_CHUNK, max_items - delivered});
+                size_t ok = 0;
+                while (ok < n && read(seq + ok, buf[ok]))
+                    ++ok;
+                if (ok)
+                {
+                    fn(std::span<const T>(buf, ok));
+                    seq += ok;
+                    delivered += ok;
+                }
+                if (ok < n)
+                {
+                    // lapped: jump to the oldest item still in the ring
+                    const uint64_t oldest = head_.load(std::memory_order_acquire) - capacity();
+                    c.dropped.fetch_add(oldest - seq, std::memory_order_relaxed);
+                    seq = oldest;
+                }
+            }
+        }
+        c.next.store(seq, std::memory_order_release);
+        return delivered;
+    }
+
+    // Move the cursor to the head without reading; returns the items skipped
+    size_t skip_all(Cursor &c)
+    {
+        const uint64_t seq = c.next.load(std::memory_order_relaxed);
+        const uint64_t h = head_.load(std::memory_order_acquire);
+        c.next.store(h, std::memory_order_release);
+        return static_cast<size_t>(h - seq);
+    }
+
+    bool empty(const Cursor &c) const
+    {
+        return c.next.load(std::memory_order_relaxed) == head_.load(std::memory_order_acquire);
+    }
+
+    uint64_t published() const { return head_.load(std::memory_order_acquire); }
+
+private:
+    static constexpr uint64_t EMPTY = UINT64_MAX;
+    static constexpr uint64_t BUSY = UINT64_MAX - 1;
+    static constexpr size_t COPY_CHUNK = 64; // non-gating poll_batch copy buffer
+
+    bool read(uint64_t seq, T &out) const
+    {
+        const size_t idx = seq & mask_;
+        if (stamps_[idx].load(std::memory_order_acquire) != seq)
+            return false;
+        out = values_[idx];
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return stamps_[idx].load(std::memory_order_relaxed) == seq;
+    }
+
+    uint64_t min_gating(uint64_t h) const
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst); // see subscribe
+        const size_t n = count_.load(std::memory_order_acquire);
+        uint64_t m = h;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const Cursor &c = cursors_[i];
+            if (c.active.load(std::memory_order_acquire) && c.gating.load(std::memory_order_relaxed))
+                m = std::min(m, c.next.load(std::memory_order_acquire));
+        }
+        // a cursor still being subscribed: never further back than a full ring
+        return std::max(m, h - std::min<uint64_t>(h, capacity()));
+    }
+
+    size_t mask_;
+    std::unique_ptr<T[]> values_;                      // contiguous: poll_batch spans
+    std::unique_ptr<std::atomic<uint64_t>[]> stamps_; // sequence held by each slot (seqlock stamp)
+    alignas(64) std::atomic<uint64_t> head_{0}; // items published
+    uint64_t gate_cache_ = 0;                   // producer-only: last slowest gating cursor
+    std::unique_ptr<Cursor[]> cursors_;         // fixed: the producer scans it while others subscribe
+    std::atomic<size_t> count_{0};              // cursor slots ever used (release: slot initialised)
+};
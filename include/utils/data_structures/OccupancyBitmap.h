@@ -0,0 +1,134 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Hierarchical occupancy bitmap
+// - Level 0 holds one bit per slot, each upper level one bit per non-zero
+//   word of the level below, up to a single root word.
+//   (64 slots per leaf word -> 2 levels cover 4096 slots, 3 levels 262144)
+// - find_next / find_prev climb until a word has a candidate bit, then
+//   descend with countr_zero / countl_zero: a few instructions per level,
+//   independent of how many empty slots sit in between.
+// - set / clear stop climbing as soon as the summary bit is already right.
+//
+// Used by LadderBookSide to find the next non-empty price level.
+class OccupancyBitmap
+{
+public:
+    static constexpr size_t NPOS = static_cast<size_t>(-1);
+
+    explicit OccupancyBitmap(size_t bits = 0) { resize(bits); }
+
+    // Resize and clear all bits
+    void resize(size_t bits)
+    {
+        bits_ = bits;
+        levels_.clear();
+        size_t n = bits;
+        size_t words;
+        do
+        {
+            words = (n + 63) / 64;
+            levels_.emplace_back(words, 0);
+            n = words;
+        } while (words > 1);
+    }
+
+    size_t size() const { return bits_; }
+    bool any() const { return !levels_.back().empty() && levels_.back()[0] != 0; }
+
+    bool test(size_t i) const
+    {
+        return (levels_[0][i >> 6] >> (i & 63)) & 1u;
+    }
+
+    void set(size_t i)
+    {
+        for (auto &level : levels_)
+        {
+            uint64_t &word = level[i >> 6];
+            const bool was_empty = word == 0;
+            word |= uint64_t{1} << (i & 63);
+            if (!was_empty)
+                break; // summary bits above are already set
+            i >>= 6;
+        }
+    }
+
+    void clear(size_t i)
+    {
+        for (auto &level : levels_)
+        {
+            uint64_t &word = level[i >> 6];
+            word &= ~(uint64_t{1} << (i & 63));
+            if (word != 0)
+                break; // word still occupied, summary unchanged
+            i >>= 6;
+        }
+    }
+
+    // First set bit >= i (NPOS if none)
+    size_t find_next(size_t i) const
+    {
+        if (i >= bits_)
+            return NPOS;
+
+        size_t l = 0;
+        for (;;)
+        {
+            const size_t w = i >> 6;
+            if (w >= levels_[l].size())
+                return NPOS;
+            const uint64_t word = levels_[l][w] & (~uint64_t{0} << (i & 63));
+            if (word)
+            {
+                i = (w << 6) | static_cast<size_t>(std::countr_zero(word));
+                break;
+            }
+            if (l + 1 == levels_.size())
+                return NPOS;
+            i = w + 1; // continue after this word one level up
+            ++l;
+        }
+        while (l-- > 0)
+            i = (i << 6) | static_cast<size_t>(std::countr_zero(levels_[l][i]));
+        return i;
+    }
+
+    // Last set bit <= i (NPOS if none)
+    size_t find_prev(size_t i) const
+    {
+        if (bits_ == 0)
+            return NPOS;
+        if (i >= bits_)
+            i = bits_ - 1;
+
+        size_t l = 0;
+        for (;;)
+        {
+            const size_t w = i >> 6;
+            const uint64_t word = levels_[l][w] & (~uint64_t{0} >> (63 - (i & 63)));
+            if (word)
+            {
+                i = (w << 6) | static_cast<size_t>(63 - std::countl_zero(word));
+                break;
+            }
+            if (w == 0 || l + 1 == levels_.size())
+                return NPOS;
+            i = w - 1; // continue before this word one level up
+            ++l;
+        }
+        while (l-- > 0)
+            i = (i << 6) | static_cast<size_t>(63 - std::countl_zero(levels_[l][i]));
+        return i;
+    }
+
+    size_t first() const { return find_next(0); }
+    size_t last() const { return bits_ ? find_prev(bits_ - 1) : NPOS; }
+
+private:
+    std::vector<std::vector<uint64_t>> levels_; // [0] = leaf bits, back() = root word
+    size_t bits_ = 0;
+};
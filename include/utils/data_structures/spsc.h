@@ -1,10 +1,19 @@
 // spsc.h
 #pragma once
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
+// ---------------------------
 // Single-Producer, Single-Consumer ring buffer
+// - head_ (producer) and tail_ (consumer) sit on their own cache lines, away
+//   from the read-only mask_/buf_, so the two threads never false-share.
+// - Each side keeps a private copy of the other side's index and only
+//   reloads it (one acquire load of a remote line) when the ring looks full
+//   (producer) or empty (consumer).
+// - push_n/pop_n move a batch and publish it with a single release store.
+
 template <typename T>
 class SPSC
 {
@@ -14,26 +23,90 @@ public:
         // cap must be power of two
     }
 
+    size_t capacity() const { return buf_.size(); }
+
+    // ---- producer ----
+
     bool push(const T &v)
     {
-        auto h = head_.load(std::memory_order_relaxed);
-        auto n = h + 1;
-        if (n - tail_.load(std::memory_order_acquire) > buf_.size())
-            return false;
+        const uint64_t h = head_.load(std::memory_order_relaxed);
+        if (h - cached_tail_ == buf_.size())
+        {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (h - cached_tail_ == buf_.size())
+                return false;
+        }
         buf_[h & mask_] = v;
-        head_.store(n, std::memory_order_release);
+        head_.store(h + 1, std::memory_order_release);
         return true;
     }
 
+    // Push up to n items with one release store; returns how many fit
+    size_t push_n(const T *items, size_t n)
+    {
+        const uint64_t h = head_.load(std::memory_order_relaxed);
+        size_t free = buf_.size() - static_cast<size_t>(h - cached_tail_);
+        if (free < n)
+        {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            free = buf_.size() - static_cast<size_t>(h - cached_tail_);
+            if (n > free)
+                n = free;
+        }
+        for (size_t i = 0; i < n; ++i)
+            buf_[(h + i) & mask_] = items[i];
+        if (n)
+            head_.store(h + n, std::memory_order_release);
+        return n;
+    }
+
+    // ---- consumer ----
+
     bool pop(T &out)
     {
-        auto t = tail_.load(std::memory_order_relaxed);
-        if (head_.load(std::memory_order_acquire) == t)
-            return false;
+        const uint64_t t = tail_.load(std::memory_order_relaxed);
+        if (cached_head_ == t)
+        {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (cached_head_ == t)
+                return false;
+        }
         out = buf_[t & mask_];
         tail_.store(t + 1, std::memory_order_release);
         return true;
     }
+
+    // Oldest unconsumed item without consuming it (nullptr when empty)
+    const T *front()
+    {
+        const uint64_t t = tail_.load(std::memory_order_relaxed);
+        if (cached_head_ == t)
+        {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (cached_head_ == t)
+                return nullptr;
+        }
+        return &buf_[t & mask_];
+    }
+
+    // Pop up to max_items into out with one release store; returns how many
+    size_t pop_n(T *out, size_t max_items)
+    {
+        const uint64_t t = tail_.load(std::memory_order_relaxed);
+        size_t avail = static_cast<size_t>(cached_head_ - t);
+        if (avail < max_items)
+        {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            avail = static_cast<size_t>(cached_head_ - t);
+        }
+        const size_t n = avail < max_items ? avail : max_items;
+        for (size_t i = 0; i < n; ++i)
+            out[i] = buf_[(t + i) & mask_];
+        if (n)
+            tail_.store(t + n, std::memory_order_release);
+        return n;
+    }
+
     std::vector<T> snapshot(size_t n = 0) const
     {
         std::vector<T> out;
@@ -54,7 +127,18 @@ public:
     }
 
 private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    // read-only after construction
     size_t mask_;
     std::vector<T> buf_;
-    std::atomic<uint64_t> head_{0}, tail_{0};
+
+    // producer line
+    alignas(CACHE_LINE) std::atomic<uint64_t> head_{0};
+    uint64_t cached_tail_ = 0; // producer's last view of tail_
+
+    // consumer line
+    alignas(CACHE_LINE) std::atomic<uint64_t> tail_{0};
+    uint64_t cached_head_ = 0; // consumer's last view of head_
+    // (alignas rounds sizeof up to whole lines: neighbours stay off the consumer line)
 };
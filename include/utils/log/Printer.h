@@ -22,7 +22,7 @@ namespace printer
         os << '[' << CYAN << "Time: " << o.timestamp << RESET << "] | "
            << ((o.side() == Order::Side::Buy) ? BUY_STR : SELL_STR)
            << " | ID: " << o.id
-           << " | Price: " << o.price
+           << " | Price: " << DEFAULT_INSTRUMENT.to_price(o.price)
            << " | Qty: " << o.quantity;
     }
 
@@ -35,7 +35,7 @@ namespace printer
            << (matched.isBuy() ? BUY_STR : SELL_STR)
            << " order (ID: " << matched.id << ") for "
            << CYAN << quantity << RESET
-           << " units at price " << CYAN << matched.price << RESET
+           << " units at price " << CYAN << DEFAULT_INSTRUMENT.to_price(matched.price) << RESET
            << '\n';
     }
 }
\ No newline at end of file
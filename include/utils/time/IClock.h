@@ -0,0 +1,12 @@
+#pragma once
+#include "utils/time/Timestamp.h"
+
+struct IClock
+{
+    virtual ~IClock() = default;
+    virtual Timestamp now() = 0;
+};
+
+// Process-wide clock shared by feeders and the engine (one timebase):
+// a calibrated TscClock when the TSC is invariant, else a MonotonicClock
+IClock &default_clock();
@@ -0,0 +1,20 @@
+#pragma once
+#include "utils/time/IClock.h"
+
+#include <atomic>
+
+// Time moves only when told to: replays and deterministic tests.
+// Safe to read from any thread while one thread drives it.
+class ManualClock final : public IClock
+{
+public:
+    explicit ManualClock(Timestamp start = 0) : now_(start) {}
+
+    Timestamp now() override { return now_.load(std::memory_order_acquire); }
+
+    void set(Timestamp ts) { now_.store(ts, std::memory_order_release); }
+    void advance(Timestamp ns) { now_.fetch_add(ns, std::memory_order_acq_rel); }
+
+private:
+    std::atomic<Timestamp> now_;
+};
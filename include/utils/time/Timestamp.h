@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstdint>
+
+// Nanoseconds on std::chrono::steady_clock's timebase (CLOCK_MONOTONIC on
+// Linux): orders, events and trades all carry one, so differences between
+// them are latencies. Read them through an IClock (utils/time/IClock.h).
+using Timestamp = uint64_t;
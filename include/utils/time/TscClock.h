@@ -0,0 +1,64 @@
+#pragma once
+#include "utils/time/IClock.h"
+#include "utils/time/MonotonicClock.h"
+
+#include <chrono>
+#include <cstdint>
+
+// rdtsc intrinsics and a 128-bit multiply (GCC/Clang on x86-64)
+#if defined(__x86_64__) && defined(__SIZEOF_INT128__)
+#define TSC_CLOCK_AVAILABLE 1
+#include <x86intrin.h>
+#else
+#define TSC_CLOCK_AVAILABLE 0
+#endif
+
+// ---------------------------
+// Timestamps from the CPU's time-stamp counter
+// - One rdtsc plus a multiply-shift per read (a few ns), no vDSO call.
+// - Calibrated at construction against MonotonicClock (steady_clock), so
+//   both share one timebase and can be mixed.
+// - Only trusted when CPUID reports an invariant TSC (constant rate, keeps
+//   counting in deep C-states, synchronised across cores). Otherwise, and
+//   on toolchains without TSC_CLOCK_AVAILABLE, every read falls back to
+//   MonotonicClock.
+// - Drifts from MonotonicClock by the calibration error (ppm range): fine
+//   for latencies, recalibrate for long-running wall-clock alignment.
+
+class TscClock final : public IClock
+{
+public:
+    static constexpr auto DEFAULT_CALIBRATION = std::chrono::milliseconds(10);
+
+    explicit TscClock(std::chrono::nanoseconds calibration = DEFAULT_CALIBRATION);
+
+    Timestamp now() override { return read(); }
+
+    Timestamp read() const noexcept
+    {
+#if TSC_CLOCK_AVAILABLE
+        if (use_tsc_) [[likely]]
+        {
+            const uint64_t dt = __rdtsc() - base_tsc_;
+            return base_ns_ + static_cast<Timestamp>((static_cast<unsigned __int128>(dt) * mult_) >> SHIFT);
+        }
+#endif
+        return MonotonicClock::read();
+    }
+
+    // CPUID: x86 with the invariant-TSC bit set
+    static bool invariant_tsc();
+
+    bool uses_tsc() const { return use_tsc_; }
+    double ticks_per_ns() const { return use_tsc_ ? static_cast<double>(uint64_t{1} << SHIFT) / mult_ : 0.0; }
+
+private:
+    static constexpr unsigned SHIFT = 32; // mult_ = ns per tick in 32.32 fixed point
+
+    void calibrate(std::chrono::nanoseconds span);
+
+    bool use_tsc_ = false;
+    uint64_t base_tsc_ = 0;
+    Timestamp base_ns_ = 0;
+    uint64_t mult_ = 0;
+};
@@ -20,14 +20,15 @@
 #endif
 // std::random_device Realistic randomness Default for simulations
 // Fixed seed Reproducible tests or benchmarks
-MarketFeeder::MarketFeeder(ThreadSafeQueue<Order> &queue, std::shared_ptr<IRNG> rng, uint16_t feeder_id, uint32_t delay)
-    : queue_(queue), running_(false), order_id_(0), rng_(std::move(rng)), feeder_id_(feeder_id), delay_(delay)
+MarketFeeder::MarketFeeder(OrderLane &lane, std::shared_ptr<IRNG> rng, uint16_t feeder_id, uint32_t delay, IClock &clock)
+    : running_(false), lane_(lane), clock_(clock), delay_(delay), feeder_id_(feeder_id), order_id_(0), rng_(std::move(rng))
 {
 }
 
 void MarketFeeder::start()
 {
     running_ = true;
+    lane_.open(clock_.now());
     worker_ = std::thread(&MarketFeeder::run, this);
 }
 
@@ -36,13 +37,12 @@ void MarketFeeder::stop()
     running_ = false;
     if (worker_.joinable())
         worker_.join();
+    lane_.close(); // an idle feeder must not hold back the merge
 }
 
 void MarketFeeder::run()
 {
-    auto now = std::chrono::steady_clock::now();
-    auto seed = static_cast<unsigned int>(
-        std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count());
+    auto seed = static_cast<unsigned int>(clock_.now() / 1'000'000); // ms
     std::mt19937 sleep_rng(seed);
     const int DELAY_NOISE = DELAY_JITTER * feeder_id_ + delay_;
     std::uniform_int_distribution<int> sleep_dist(DELAY_MIN + DELAY_NOISE, DELAY_MAX + DELAY_NOISE);
@@ -50,8 +50,10 @@ void MarketFeeder::run()
     while (running_)
     {
         Order order = generate_order();
-        queue_.push(std::move(order));
-        // We made ThreadSafeQueue emplace-friendly to support perfect forwarding
+        // Lane full: back off until the engine catches up (or we are stopped)
+        while (!lane_.try_push(order) && running_)
+            std::this_thread::yield();
+        // We made the queue emplace-friendly to support perfect forwarding
         // This avoids Default constructing order & Avoids Moving it into the queue
         // queue_.emplace(
         //     /* orderId   */ GET_ASSIGN_ORDER_ID_VALUE(feeder_id_, order_id_),
@@ -70,10 +72,8 @@ Order MarketFeeder::generate_order()
     using Side = Order::Side;
     Order order; // we basicaly call the default constructor and then set each field
     ASSIGN_ORDER_ID(order, feeder_id_, order_id_);
-    order.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-                          std::chrono::steady_clock::now().time_since_epoch())
-                          .count();
-    order.price = rng_->uniform_real(PRICE_MIN, PRICE_MAX);
+    order.timestamp = clock_.now();
+    order.price = DEFAULT_INSTRUMENT.to_ticks(rng_->uniform_real(PRICE_MIN, PRICE_MAX));
     order.quantity = static_cast<uint32_t>(rng_->uniform_int(QTY_MIN, QTY_MAX));
     // order.side = static_cast<Side>(rng_->uniform_int(SIDE_MIN, SIDE_MAX));
     order.setSide(static_cast<Order::Side>(rng_->uniform_int(0, 1)));
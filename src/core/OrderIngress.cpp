@@ -0,0 +1,53 @@
+#include "core/OrderIngress.h"
+
+OrderIngress::OrderIngress(size_t lanes, size_t lane_capacity_pow2)
+{
+    lanes_.reserve(lanes);
+    for (size_t i = 0; i < lanes; ++i)
+        lanes_.push_back(std::make_unique<OrderLane>(lane_capacity_pow2, &bell_));
+}
+
+OrderLane *OrderIngress::next_lane()
+{
+    // Feeders are few (one per spare core): a linear scan for the minimum
+    // head beats maintaining a heap across lanes that refill concurrently.
+    OrderLane *best = nullptr;
+    uint64_t best_ts = OrderLane::CLOSED;
+    bool best_ready = false;
+
+    for (auto &lane : lanes_)
+    {
+        // Watermark before head: an empty lane then has nothing older queued
+        const uint64_t watermark = lane->watermark();
+        const Order *head = lane->front();
+        const uint64_t ts = head ? head->timestamp : watermark;
+
+        // strict '<' keeps the lowest lane index on equal timestamps
+        if (!best || ts < best_ts)
+        {
+            best = lane.get();
+            best_ts = ts;
+            best_ready = head != nullptr;
+        }
+    }
+
+    // Empty, or an idle lane may still publish something that sorts first
+    return best_ready ? best : nullptr;
+}
+
+size_t OrderIngress::drain(std::vector<Order> &out, size_t max_items)
+{
+    size_t n = 0;
+    while (n < max_items)
+    {
+        OrderLane *lane = next_lane();
+        if (!lane)
+            break;
+
+        Order order;
+        lane->pop(order);
+        out.push_back(order);
+        ++n;
+    }
+    return n;
+}
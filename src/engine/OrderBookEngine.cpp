@@ -1,116 +1,224 @@
 #include "engine/OrderBookEngine.h"
 #include "utils/log/DebugLog.h"
 
-#include <numeric>
+#include <utility>
+#include <type_traits>
 #include <algorithm>
 #include <iostream>
 
-OrderBookEngine::OrderBookEngine(EventBus &bus, std::unique_ptr<IMatchingStrategy> strategy)
-    : bidsView_(bids_),
-      asksView_(asks_),
+// Build one side on its backend (ladder sides take the configured window)
+template <typename Side>
+static Side make_side(OrderPool &pool, const OrderBookEngineConfig &config)
+{
+    if constexpr (std::is_constructible_v<Side, OrderPool &, const OrderBookEngineConfig &>)
+        return Side(pool, config);
+    else if constexpr (std::is_constructible_v<Side, OrderPool &, size_t, size_t>)
+        return Side(pool, config.ladder_window_ticks, config.ladder_max_window_ticks);
+    else
+        return Side(pool);
+}
+
+template <typename Strategy, template <typename> class BookSide>
+BasicOrderBookEngine<Strategy, BookSide>::BasicOrderBookEngine(EventBus &bus, Strategy strategy, OrderBookEngineConfig config)
+    : pool_(config.order_capacity),
+      bids_(make_side<BidSide>(pool_, config)),
+      asks_(make_side<AskSide>(pool_, config)),
       bus_(bus),
+      clock_(config.clock ? *config.clock : default_clock()),
       matching_strategy_(std::move(strategy)),
-      tick_times_(std::make_unique<WallTime[]>(MAX_TICKS))
+      id_index_(config.order_capacity * 2, config.id_index_mode, config.id_feeder_window)
 {
     // Subscribe book sides to the bus
-    bus_.add_listener([this](const Event &e)
-                      { bids_.on_event(e); });
-    bus_.add_listener([this](const Event &e)
-                      { asks_.on_event(e); });
+    bid_listener_ = bus_.add_listener(bids_); // typed, non-owning: removed in the destructor
+    ask_listener_ = bus_.add_listener(asks_);
 }
 
-WallTime OrderBookEngine::get_current_wall_time() const
+template <typename Strategy, template <typename> class BookSide>
+BasicOrderBookEngine<Strategy, BookSide>::~BasicOrderBookEngine()
 {
-    // real-world timestamp in milliseconds
-    using namespace std::chrono;
-    return duration_cast<milliseconds>(
-               steady_clock::now().time_since_epoch())
-        .count();
+    // The listeners capture this: stop them before the sides go away
+    bus_.remove_listener(bid_listener_);
+    bus_.remove_listener(ask_listener_);
+}
+
+template <typename Strategy, template <typename> class BookSide>
+template <typename Payload>
+void BasicOrderBookEngine<Strategy, BookSide>::emit(const Payload &payload)
+{
+    if (batching_)
+        pending_events_.push_back(Event::make(now_, ++next_seq_, payload));
+    else
+        bus_(now_, ++next_seq_, payload);
 }
 
-void OrderBookEngine::advance_tick()
+// Aggregate resting quantity at px (0 once the level is gone)
+template <typename Side>
+static int64_t level_qty(const Side &side, Price px)
 {
-    if (current_tick_ >= MAX_TICKS)
-        current_tick_ = 0; // or handle overflow differently
-    // Increment the logical tick once per engine cycle
-    current_tick_++;
-    // save real-world timestamp per tick
-    tick_times_[current_tick_] = get_current_wall_time();
-    // Reset sequence number at the start of each tick
-    next_seq_ = 0;
+    return side.empty_at_price(px) ? 0 : static_cast<int64_t>(side.get_orders_at_price(px).aggregate_qty());
 }
 
-std::span<const WallTime> OrderBookEngine::tick_wall_times() const
+template <typename Strategy, template <typename> class BookSide>
+void BasicOrderBookEngine<Strategy, BookSide>::flush_levels()
 {
-    return std::span{tick_times_.get(), MAX_TICKS};
+    // A listener saw a gap: republish every level (the L2 snapshot) with this operation
+    if (bus_.take_resync_request())
+    {
+        bids_.for_each_level([&](const PriceLevelView &lvl)
+                             { touch_level(Order::Side::Buy, lvl.price); });
+        asks_.for_each_level([&](const PriceLevelView &lvl)
+                             { touch_level(Order::Side::Sell, lvl.price); });
+    }
+
+    // A sweep touches a level once per fill: report each level only once
+    if (touched_levels_.size() > 1)
+    {
+        std::ranges::sort(touched_levels_);
+        const auto dup = std::ranges::unique(touched_levels_);
+        touched_levels_.erase(dup.begin(), dup.end());
+    }
+    for (const auto &[side, px] : touched_levels_)
+    {
+        const int64_t qty = side == Order::Side::Buy ? level_qty(std::as_const(bids_), px)
+                                                     : level_qty(std::as_const(asks_), px);
+        emit(E_LevelAgg{side, px, qty});
+    }
+    touched_levels_.clear();
 }
 
-void OrderBookEngine::add_order(Order &order)
+template <typename Strategy, template <typename> class BookSide>
+void BasicOrderBookEngine<Strategy, BookSide>::add_order(Order &order)
 {
-    // advance time ticks & seq
-    advance_tick();
+    read_clock();
 
     // Determine the side
     if (order.isBuy())
-        add_order_to_side(bids_, order);
+        add_order_to_side(bids_, asks_, order);
     else
-        add_order_to_side(asks_, order);
+        add_order_to_side(asks_, bids_, order);
+    flush_levels();
 }
 
-void OrderBookEngine::cancel_order(uint64_t order_id)
+template <typename Strategy, template <typename> class BookSide>
+void BasicOrderBookEngine<Strategy, BookSide>::add_orders(std::span<Order> orders)
 {
-    auto it = id_lookup_.find(order_id);
-    if (it == id_lookup_.end())
+    if (orders.empty())
         return;
 
-    auto &[side, price, order_it] = it->second;
+    // One clock read for the whole batch; seq keeps counting
+    read_clock();
+
+    batching_ = true;
+    for (Order &order : orders)
+    {
+        if (order.isBuy())
+            add_order_to_side(bids_, asks_, order);
+        else
+            add_order_to_side(asks_, bids_, order);
+    }
+    flush_levels(); // final sizes for the whole batch
+    batching_ = false;
+
+    // Hand the batch's events to each listener in one go
+    bus_.publish(std::span<const Event>(pending_events_));
+    pending_events_.clear();
+}
+
+template <typename Strategy, template <typename> class BookSide>
+void BasicOrderBookEngine<Strategy, BookSide>::cancel_order(uint64_t order_id)
+{
+    const OrderHandle h = id_index_.find(order_id);
+    if (h == NULL_ORDER_HANDLE)
+        return;
+
+    read_clock();
+    const Order::Side side = pool_[h].side();
+    const Price price = pool_[h].price;
+    id_index_.erase(order_id);
 
     if (side == Order::Side::Buy)
-        cancel_order_on_side(bids_, side, price, order_it);
+        cancel_order_on_side(bids_, side, price, OrderIterator{&pool_, h});
     else
-        cancel_order_on_side(asks_, side, price, order_it);
-
-    id_lookup_.erase(it);
+        cancel_order_on_side(asks_, side, price, OrderIterator{&pool_, h});
+    touch_level(side, price);
+    flush_levels();
 }
 
-template <typename SideType>
-void OrderBookEngine::add_order_to_side(SideType &book_side, Order &incoming)
+template <typename Strategy, template <typename> class BookSide>
+struct BasicOrderBookEngine<Strategy, BookSide>::FillSink
 {
-    DEBUG_ENGINE("Adding {}", incoming);
+    BasicOrderBookEngine &engine;
+    uint64_t taker_id;
 
-    // 1️⃣ Match against opposite side
-    const IOrderBookSideView &oppositeView = incoming.isBuy() ? asksView_ : bidsView_;
-    std::vector<FillOp> fills;
+    void on_fill(const Order &maker, Price px, uint32_t qty)
+    {
+        engine.emit(E_Fill{maker.id, taker_id, px, qty});
+    }
 
-    MatchResult result = matching_strategy_->match(incoming, oppositeView, fills);
-    DEBUG_ENGINE("{}", result);
+    void on_maker_filled(const Order &maker)
+    {
+        DEBUG_ENGINE("Order ID={} fully filled, removing from book", maker.id);
+        engine.id_index_.erase(maker.id);
+        engine.emit(E_OrderRemoved{maker.id});
+    }
 
-    // 2️⃣ Publish fills
-    for (const auto &fill : fills)
+    void on_level(Order::Side side, Price px, const IOrderBookSide::OrderList &)
     {
-        bus_(current_tick_, next_seq_++, E_Fill{fill.makerOrderId, fill.makerOrderId, fill.price, fill.quantity});
+        engine.touch_level(side, px);
     }
+};
 
-    // 3️⃣ Apply fills to resting orders
-    apply_fill_ops(fills);
+template <typename Strategy, template <typename> class BookSide>
+template <typename Side, typename OppositeSide>
+void BasicOrderBookEngine<Strategy, BookSide>::add_order_to_side(Side &book_side, OppositeSide &opposite, Order &incoming)
+{
+    DEBUG_ENGINE("Adding {}", incoming);
 
-    // 4️⃣ Reduce incoming quantity set zero if below zero
-    DEBUG_SUBTRACT_INT64(DEBUG_ENGINE, "remaining_qty (add_order_to_side) = ", incoming.quantity, result.filledQty);
-    incoming.quantity = result.filledQty >= incoming.quantity ? 0 : incoming.quantity - result.filledQty;
+    if constexpr (requires(FillSink &sink) { matching_strategy_.execute(incoming, opposite, sink); })
+    {
+        // 1️⃣ Fused: match, fill makers in place and publish in one pass
+        FillSink sink{*this, incoming.id};
+        MatchResult result = matching_strategy_.execute(incoming, opposite, sink);
+        DEBUG_ENGINE("{}", result);
+    }
+    else
+    {
+        // 1️⃣ Plan: match against opposite side
+        const uint32_t original_qty = incoming.quantity; // strategy may already reflect the fills
+        std::vector<FillOp> &fills = fill_ops_;
+        fills.clear(); // reused buffer: no allocation once warmed up
+
+        MatchResult result = matching_strategy_.match_side(incoming, std::as_const(opposite), fills);
+        DEBUG_ENGINE("{}", result);
+
+        // 2️⃣ Publish fills
+        for (const auto &fill : fills)
+        {
+            emit(E_Fill{fill.makerOrderId, incoming.id, fill.price, fill.quantity});
+        }
+
+        // 3️⃣ Apply fills to resting orders
+        apply_fill_ops(fills);
+
+        // 4️⃣ Reduce incoming quantity set zero if below zero
+        DEBUG_SUBTRACT_INT64(DEBUG_ENGINE, "remaining_qty (add_order_to_side) = ", original_qty, result.filledQty);
+        incoming.quantity = result.filledQty >= original_qty ? 0 : original_qty - result.filledQty;
+    }
     DEBUG_ENGINE("After applying fills, incoming qty={}", incoming.quantity);
 
     // 5️⃣ If any quantity remains and not IOC/FOK, insert into book
-    if (incoming.quantity > 0 && !(incoming.isIOC() || incoming.isFOK()))
+    const bool rests = incoming.quantity > 0 && !(incoming.isIOC() || incoming.isFOK());
+    if (rests && book_side.accepts_price(incoming.price))
     {
         auto it = book_side.add_order_and_get_iterator(incoming);
-        id_lookup_[incoming.id] = std::make_tuple(incoming.side(), incoming.price, it);
+        id_index_.insert(incoming.id, it.handle());
         DEBUG_ENGINE("Added to book side {}", incoming);
-        // Publish both OrderAdded and LevelAgg
-        bus_(current_tick_, next_seq_++, E_OrderAdded{incoming.id, incoming.side(), incoming.price, incoming.quantity});
-        // Publish LevelAgg for OrderBookView
-        auto &orders_at_price = book_side.get_orders_at_price(incoming.price);
-        bus_(current_tick_, next_seq_++, E_LevelAgg{incoming.side(), incoming.price, std::accumulate(orders_at_price.begin(), orders_at_price.end(), int64_t(0), [](int64_t sum, const Order &o)
-                                                                                                     { return sum + o.quantity; })});
+        emit(E_OrderAdded{incoming.id, incoming.side(), incoming.price, incoming.quantity});
+        touch_level(incoming.side(), incoming.price); // LevelAgg for OrderBookView once the operation ends
+    }
+    else if (rests)
+    {
+        DEBUG_ENGINE("Canceled (price outside the side's range) {}", incoming);
     }
     else if (incoming.quantity > 0)
     {
@@ -118,66 +226,58 @@ void OrderBookEngine::add_order_to_side(SideType &book_side, Order &incoming)
     }
 }
 
-void OrderBookEngine::apply_fill_ops(const std::vector<FillOp> &fills)
+template <typename Strategy, template <typename> class BookSide>
+void BasicOrderBookEngine<Strategy, BookSide>::apply_fill_ops(const std::vector<FillOp> &fills)
 {
     for (const auto &fill : fills)
     {
         DEBUG_ENGINE("Applying {}", fill);
 
-        auto it = id_lookup_.find(fill.makerOrderId);
-        if (it == id_lookup_.end())
+        const OrderHandle h = id_index_.find(fill.makerOrderId);
+        if (h == NULL_ORDER_HANDLE)
         {
-            DEBUG_ENGINE("Maker order not found in id_lookup_ (id={})", fill.makerOrderId);
+            DEBUG_ENGINE("Maker order not found in id_index_ (id={})", fill.makerOrderId);
             continue;
         }
 
-        auto &[side, price, order_it] = it->second;
-
-        // Reduce quantity set zero if below zero
-        DEBUG_SUBTRACT_INT64(DEBUG_ENGINE, "remaining_qty (apply_fill_ops) = ", order_it->quantity, fill.quantity);
-        order_it->quantity = fill.quantity >= order_it->quantity ? 0 : order_it->quantity - fill.quantity;
-        DEBUG_ENGINE("Order ID={} new qty={}", fill.makerOrderId, order_it->quantity);
-
-        if (order_it->quantity == 0)
-        {
-            DEBUG_ENGINE("Order ID={} fully filled, removing from book", fill.makerOrderId);
+        OrderIterator order_it{&pool_, h};
+        if (order_it->side() == Order::Side::Buy)
+            apply_fill(bids_, fill, order_it);
+        else
+            apply_fill(asks_, fill, order_it);
+    }
+}
 
-            if (side == Order::Side::Buy)
-                cancel_order_on_side(bids_, side, price, order_it);
-            else
-                cancel_order_on_side(asks_, side, price, order_it);
+template <typename Strategy, template <typename> class BookSide>
+template <typename Side>
+void BasicOrderBookEngine<Strategy, BookSide>::apply_fill(Side &book_side, const FillOp &fill, OrderIterator order_it)
+{
+    const Order::Side side = order_it->side();
+    const Price price = order_it->price;
+    auto &orders_at_price = book_side.get_orders_at_price(price);
 
-            id_lookup_.erase(it);
+    // Reduce quantity set zero if below zero (keeps the level aggregate in step)
+    DEBUG_SUBTRACT_INT64(DEBUG_ENGINE, "remaining_qty (apply_fill_ops) = ", order_it->quantity, fill.quantity);
+    orders_at_price.reduce(order_it, fill.quantity);
+    DEBUG_ENGINE("Order ID={} new qty={}", fill.makerOrderId, order_it->quantity);
 
-            // Level is now empty, publish LevelAgg with 0
-            bus_(current_tick_, next_seq_++, E_LevelAgg{side, price, 0});
-        }
-        else
-        {
+    if (order_it->quantity == 0)
+    {
+        DEBUG_ENGINE("Order ID={} fully filled, removing from book", fill.makerOrderId);
 
-            // Level still exists, publish new quantity
-            if (side == Order::Side::Buy)
-            {
-                auto &orders_at_price = bids_.get_orders_at_price(price);
-                bus_(current_tick_, next_seq_++, E_LevelAgg{side, price, std::accumulate(orders_at_price.begin(), orders_at_price.end(), int64_t(0), [](int64_t sum, const Order &o)
-                                                                                         { return sum + o.quantity; })});
-            }
-            else
-            {
-                auto &orders_at_price = asks_.get_orders_at_price(price);
-                bus_(current_tick_, next_seq_++, E_LevelAgg{side, price, std::accumulate(orders_at_price.begin(), orders_at_price.end(), int64_t(0), [](int64_t sum, const Order &o)
-                                                                                         { return sum + o.quantity; })});
-            }
-        }
+        id_index_.erase(fill.makerOrderId);
+        cancel_order_on_side(book_side, side, price, order_it);
     }
+    touch_level(side, price); // size published once the operation ends
 }
 
-template <typename SideType>
-void OrderBookEngine::cancel_order_on_side(
-    SideType &book_side,
+template <typename Strategy, template <typename> class BookSide>
+template <typename Side>
+void BasicOrderBookEngine<Strategy, BookSide>::cancel_order_on_side(
+    Side &book_side,
     Order::Side,
-    double price,
-    typename std::list<Order>::iterator order_it)
+    Price price,
+    OrderIterator order_it)
 {
     auto &orders = book_side.get_orders_at_price(price);
     if (orders.empty())
@@ -186,5 +286,10 @@ void OrderBookEngine::cancel_order_on_side(
     orders.erase(order_it);
     if (book_side.empty_at_price(price))
         book_side.remove_price_level(price);
-    bus_(current_tick_, next_seq_++, E_OrderRemoved{id});
+    emit(E_OrderRemoved{id});
 }
+
+// Explicit instantiations
+template class BasicOrderBookEngine<DynamicStrategy, DynamicBookSide>;
+template class BasicOrderBookEngine<PriceTimePriorityStrategy, OrderBookSide>;
+template class BasicOrderBookEngine<PriceTimePriorityStrategy, LadderBookSide>;
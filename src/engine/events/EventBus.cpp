@@ -1,50 +1,104 @@
 // event_bus.cpp
 #include "engine/events/EventBus.h"
+#include "utils/concurrency/ThreadAffinity.h"
 
-struct EventBus::Endpoint
+#include <algorithm>
+#include <mutex>
+
+// One pool thread. Each pooled listener is bound to a single worker, so its
+// events are delivered in order; the worker sweeps its listeners round-robin.
+struct EventBus::Worker
 {
-    std::unique_ptr<SPSC<Event>> q;
-    Callback cb;
-    Backpressure bp{Backpressure::SpinYield};
-    std::atomic<bool> run{false};
+    std::mutex mu; // held during a sweep: removal waits out a running callback
+    std::vector<Endpoint *> endpoints;
+    std::atomic<EventMask> mask{0}; // union of the endpoints' masks
+    std::atomic<bool> run{true};
     std::thread th;
+
+    std::atomic<uint64_t> wakeups{0};
+    std::atomic<uint64_t> spurious_wakeups{0};
 };
 
-EventBus::EventBus(size_t ring_pow2) : ring_pow2_(ring_pow2) {}
+EventBus::EventBus(size_t ring_pow2, size_t pool_threads, WaitStrategy pool_wait)
+    : ring_(ring_pow2), pool_threads_(pool_threads), pool_wait_(pool_wait) {}
 
 EventBus::~EventBus()
 {
     stop_all();
 }
 
-size_t EventBus::add_listener(Callback cb, Backpressure bp)
+size_t EventBus::add_listener(Callback cb, ListenerOptions opts)
+{
+    auto fn = std::make_shared<Callback>(std::move(cb));
+    Callback *self = fn.get();
+    return attach(self, &drain_as<Callback>, std::move(fn), opts);
+}
+
+size_t EventBus::attach(void *self, DrainFn drain, std::shared_ptr<void> owner, ListenerOptions opts)
 {
+    if (pool_threads_ == 0)
+        opts.dispatch = Dispatch::Dedicated;
+
     auto ep = std::make_unique<Endpoint>();
-    ep->q = std::make_unique<SPSC<Event>>(ring_pow2_);
-    ep->cb = std::move(cb);
-    ep->bp = bp;
+    // Drop and Conflate never hold the publisher back
+    ep->cursor = ring_.subscribe(opts.bp != Backpressure::Drop && opts.bp != Backpressure::Conflate);
+    ep->self = self;
+    ep->drain = drain;
+    ep->owner = std::move(owner);
+    ep->opts = opts;
     ep->run.store(true, std::memory_order_relaxed);
+    if (opts.bp == Backpressure::SpinYield)
+        yield_when_full_ = true;
+    if (opts.bp == Backpressure::Conflate)
+    {
+        ep->levels = std::make_unique<LevelTable>(opts.conflate_levels);
+        std::lock_guard<std::mutex> lock(conflating_mu_);
+        conflating_.push_back(ep.get());
+        has_conflating_.store(true, std::memory_order_relaxed);
+    }
 
-    ep->th = std::thread([p = ep.get()]()
-                         {
-        Event ev{};
-        while (p->run.load(std::memory_order_relaxed)) {
-            while (p->q->pop(ev)) {
-                if (!p->run.load(std::memory_order_relaxed))
-                    break; // stop immediately if disabled
-                p->cb(ev);
-            }
-            std::this_thread::yield();
-        }
-        // drain remaining queue without calling callbacks
-        while (p->q->pop(ev)) {
-            // discard events
-        } });
+    if (opts.dispatch == Dispatch::Dedicated)
+    {
+        ep->th = std::thread([this, p = ep.get()]
+                             { run_dedicated(*p); });
+    }
+    else
+    {
+        Worker &w = least_loaded_worker();
+        ep->worker = &w;
+        std::lock_guard<std::mutex> lock(w.mu);
+        w.endpoints.push_back(ep.get());
+        w.mask.fetch_or(opts.mask, std::memory_order_relaxed);
+        bell_.wake_all(); // a parked worker re-parks with the wider mask
+    }
 
     listeners_.push_back(std::move(ep));
     return listeners_.size() - 1;
 }
 
+EventBus::Worker &EventBus::least_loaded_worker()
+{
+    if (workers_.empty())
+    {
+        for (size_t i = 0; i < pool_threads_; ++i)
+        {
+            auto w = std::make_unique<Worker>();
+            w->th = std::thread([this, p = w.get()]
+                                { run_worker(*p); });
+            workers_.push_back(std::move(w));
+        }
+    }
+
+    Worker *best = workers_.front().get();
+    for (auto &w : workers_)
+    {
+        std::lock_guard<std::mutex> lock(w->mu);
+        if (w->endpoints.size() < best->endpoints.size())
+            best = w.get();
+    }
+    return *best;
+}
+
 void EventBus::remove_listener(size_t h)
 {
     if (h >= listeners_.size() || !listeners_[h])
@@ -52,16 +106,33 @@ void EventBus::remove_listener(size_t h)
 
     auto &ep = listeners_[h];
     ep->run.store(false, std::memory_order_relaxed);
-
-    // drain remaining without calling callbacks
-    Event dummy{};
-    while (ep->q->pop(dummy))
+    if (ep->worker)
+    {
+        // once we hold the lock the worker is not inside this listener's callback
+        Worker &w = *ep->worker;
+        std::lock_guard<std::mutex> lock(w.mu);
+        std::erase(w.endpoints, ep.get());
+        EventMask mask = 0;
+        for (Endpoint *other : w.endpoints)
+            mask |= other->opts.mask;
+        w.mask.store(mask, std::memory_order_relaxed);
+    }
+    else
     {
+        bell_.wake_all(); // a parked listener rechecks run
+        if (ep->th.joinable())
+            ep->th.join();
     }
 
-    if (ep->th.joinable())
-        ep->th.join();
+    if (ep->levels)
+    {
+        std::lock_guard<std::mutex> lock(conflating_mu_);
+        std::erase(conflating_, ep.get());
+        has_conflating_.store(!conflating_.empty(), std::memory_order_relaxed);
+    }
 
+    // remaining events are left unread: the cursor no longer gates the ring
+    ring_.unsubscribe(ep->cursor);
     listeners_[h].reset();
 }
 
@@ -70,63 +141,226 @@ void EventBus::stop_all()
     for (auto &ep : listeners_)
         if (ep)
             ep->run.store(false, std::memory_order_relaxed);
+    for (auto &w : workers_)
+        w->run.store(false, std::memory_order_relaxed);
+    bell_.wake_all();
 
+    for (auto &w : workers_)
+        if (w->th.joinable())
+            w->th.join();
     for (auto &ep : listeners_)
     {
         if (ep)
         {
-            Event dummy{};
-            while (ep->q->pop(dummy))
-            {
-            }
             if (ep->th.joinable())
                 ep->th.join();
+            ring_.unsubscribe(ep->cursor);
         }
     }
+    {
+        std::lock_guard<std::mutex> lock(conflating_mu_);
+        conflating_.clear();
+        has_conflating_.store(false, std::memory_order_relaxed);
+    }
     listeners_.clear();
+    workers_.clear();
 }
 
-void EventBus::publish(const Event &e)
+ListenerStats EventBus::listener_stats(size_t h) const
 {
-    for (auto &ep : listeners_)
+    ListenerStats stats;
+    if (h >= listeners_.size() || !listeners_[h])
+        return stats;
+
+    const auto &ep = *listeners_[h];
+    stats.delivered = ep.delivered.load(std::memory_order_relaxed);
+    if (ep.worker)
     {
-        if (ep)
-            push_one(*ep, e);
+        stats.wakeups = ep.worker->wakeups.load(std::memory_order_relaxed);
+        stats.spurious_wakeups = ep.worker->spurious_wakeups.load(std::memory_order_relaxed);
+    }
+    else
+    {
+        stats.wakeups = ep.wakeups.load(std::memory_order_relaxed);
+        stats.spurious_wakeups = ep.spurious_wakeups.load(std::memory_order_relaxed);
+    }
+    stats.dropped = ep.cursor->dropped.load(std::memory_order_relaxed);
+    stats.gaps = ep.gaps.load(std::memory_order_relaxed);
+    stats.missed = ep.missed.load(std::memory_order_relaxed);
+    if (ep.levels)
+    {
+        stats.dropped += ep.overflow.load(std::memory_order_relaxed);
+        stats.conflated = ep.levels->conflated();
     }
+    return stats;
 }
 
-template <typename Payload>
-void EventBus::operator()(Ticks ts, Seq seq, const Payload &payload)
+size_t EventBus::thread_count() const
 {
-    publish(Event::make(ts, seq, payload));
+    size_t n = workers_.size();
+    for (auto &ep : listeners_)
+        if (ep && ep->th.joinable())
+            ++n;
+    return n;
 }
 
-void EventBus::push_one(Endpoint &ep, const Event &e)
+void EventBus::run_dedicated(Endpoint &ep)
 {
-    switch (ep.bp)
+    if (ep.opts.pin_cpu >= 0)
+        pin_current_thread(ep.opts.pin_cpu);
+
+    IdleWaiter waiter(ep.opts.wait, &bell_);
+    const EventMask mask = ep.opts.mask;
+    bool woke = false;
+    while (ep.run.load(std::memory_order_relaxed))
     {
-    case Backpressure::Drop:
-        ep.q->push(e);
-        break;
-    case Backpressure::Block:
-        while (!ep.q->push(e))
+        // Nothing delivered means nothing wanted up to `seen`: sleep until that changes
+        const uint64_t seen = published_matching(mask);
+        size_t n = 0;
+        ep.drain(*this, ep, SIZE_MAX, n);
+        if (n)
+            waiter.reset();
+        else if (woke)
+            ep.spurious_wakeups.fetch_add(1, std::memory_order_relaxed);
+        woke = false;
+        auto wake = [this, &ep, mask, seen]
+        { return published_matching(mask) != seen || ring_full() || !ep.run.load(std::memory_order_relaxed); };
+        if (!n && waiter.idle(wake, mask))
         {
+            ep.wakeups.fetch_add(1, std::memory_order_relaxed);
+            woke = true;
         }
-        break;
-    case Backpressure::SpinYield:
+    }
+}
+
+void EventBus::run_worker(Worker &w)
+{
+    IdleWaiter waiter(pool_wait_, &bell_);
+    bool woke = false;
+    while (w.run.load(std::memory_order_relaxed))
     {
+        // An empty sweep means nothing wanted up to `seen`: only a newer
+        // publish of a wanted type can give this worker something to do
+        const EventMask mask = w.mask.load(std::memory_order_relaxed);
+        const uint64_t seen = published_matching(mask);
+        size_t n = 0;
+        bool backlog = false; // some listener hit POOL_BATCH: not caught up yet
+        {
+            std::lock_guard<std::mutex> lock(w.mu);
+            for (Endpoint *ep : w.endpoints)
+                backlog |= ep->drain(*this, *ep, POOL_BATCH, n) >= POOL_BATCH; // bounded: one busy listener cannot starve the rest
+        }
+
+        if (n)
+            waiter.reset();
+        else if (woke)
+            w.spurious_wakeups.fetch_add(1, std::memory_order_relaxed);
+        woke = false;
+        if (!n && !backlog && waiter.idle([this, &w, mask, seen]
+                              { return published_matching(mask) != seen || ring_full() || !w.run.load(std::memory_order_relaxed); },
+                              mask))
+        {
+            w.wakeups.fetch_add(1, std::memory_order_relaxed);
+            woke = true;
+        }
+    }
+}
+
+size_t EventBus::wait_for_slots(size_t n)
+{
+    size_t free = ring_.free_slots();
+    if (free == 0)
+    {
+        // A gating listener parked on a narrow mask is never rung by the
+        // unwanted events it has to step over: wake everyone, and keep new
+        // parks off (ready() sees ring_full_) until there is room again
+        ring_full_.store(true, std::memory_order_relaxed);
+        bell_.wake_all();
         int spins = 0;
-        while (!ep.q->push(e))
+        while (free == 0)
         {
-            if (++spins % 64 == 0)
+            if (yield_when_full_ && ++spins % 64 == 0)
                 std::this_thread::yield();
+            free = ring_.free_slots();
         }
-        break;
+        ring_full_.store(false, std::memory_order_relaxed);
+    }
+    return std::min(free, n);
+}
+
+void EventBus::publish(const Event &e)
+{
+    wait_for_slots(1);
+    ring_.write(&e, 1);
+    announce(&e, 1);
+}
+
+void EventBus::publish(std::span<const Event> events)
+{
+    for (size_t done = 0; done < events.size();)
+    {
+        const size_t n = wait_for_slots(events.size() - done);
+        ring_.write(events.data() + done, n);
+        announce(events.data() + done, n); // listeners may be parked while we wait for the next slots
+        done += n;
     }
+}
+
+void EventBus::announce(const Event *events, size_t n)
+{
+    std::array<uint64_t, EVENT_TYPE_COUNT> counts{};
+    for (size_t i = 0; i < n; ++i)
+        ++counts[static_cast<size_t>(events[i].type)];
+
+    // Conflation tables first: a listener that sees the new count must also
+    // find the levels behind it
+    if (counts[static_cast<size_t>(EventType::LevelAgg)] && has_conflating_.load(std::memory_order_relaxed))
+        conflate(events, n);
+
+    EventMask what = 0;
+    for (size_t t = 0; t < EVENT_TYPE_COUNT; ++t)
+    {
+        if (!counts[t])
+            continue;
+        // single writer: a plain add + release store, no RMW
+        auto &c = published_by_type_[t];
+        c.store(c.load(std::memory_order_relaxed) + counts[t], std::memory_order_release);
+        what |= event_bit(static_cast<EventType>(t));
     }
+    bell_.ring(what);
+}
+
+void EventBus::conflate(const Event *events, size_t n)
+{
+    std::lock_guard<std::mutex> lock(conflating_mu_);
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (events[i].type != EventType::LevelAgg)
+            continue;
+        const uint64_t key = level_key(events[i].d.level);
+        const bool gone = events[i].d.level.aggQty == 0; // level emptied: free its key once delivered
+        for (Endpoint *ep : conflating_)
+            if (!ep->levels->put(key, events[i], gone))
+                ep->overflow.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+uint64_t EventBus::published_matching(EventMask mask) const
+{
+    uint64_t total = 0;
+    for (size_t t = 0; t < EVENT_TYPE_COUNT; ++t)
+        if (mask & event_bit(static_cast<EventType>(t)))
+            total += published_by_type_[t].load(std::memory_order_acquire);
+    return total;
+}
+
+template <typename Payload>
+void EventBus::operator()(Timestamp ts, Seq seq, const Payload &payload)
+{
+    publish(Event::make(ts, seq, payload));
 }
 
-template void EventBus::operator()<E_Fill>(uint32_t, uint32_t, E_Fill const &);
-template void EventBus::operator()<E_OrderAdded>(uint32_t, uint32_t, E_OrderAdded const &);
-template void EventBus::operator()<E_OrderRemoved>(uint32_t, uint32_t, E_OrderRemoved const &);
-template void EventBus::operator()<E_LevelAgg>(uint32_t, uint32_t, E_LevelAgg const &);
+template void EventBus::operator()<E_Fill>(Timestamp, Seq, E_Fill const &);
+template void EventBus::operator()<E_OrderAdded>(Timestamp, Seq, E_OrderAdded const &);
+template void EventBus::operator()<E_OrderRemoved>(Timestamp, Seq, E_OrderRemoved const &);
+template void EventBus::operator()<E_LevelAgg>(Timestamp, Seq, E_LevelAgg const &);
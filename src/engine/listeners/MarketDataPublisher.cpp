@@ -37,6 +37,7 @@ void MarketDataPublisher::on_event(const Event &e)
 }
 
 void MarketDataPublisher::enable_ansi_escape_codes() {
+#ifdef _WIN32
     HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
     if (hOut == INVALID_HANDLE_VALUE) {
         return;
@@ -51,6 +52,7 @@ void MarketDataPublisher::enable_ansi_escape_codes() {
     if (!SetConsoleMode(hOut, dwMode)) {
         return;
     }
+#endif
 }
 
 void MarketDataPublisher::refresh_terminal()
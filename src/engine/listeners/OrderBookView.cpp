@@ -6,8 +6,27 @@ void OrderBookView::on_event(const Event &e)
         return;
 
     std::lock_guard lock(mtx_);
-    const auto &lvl = e.d.level;
+    apply_level(e.d.level);
+}
+
+void OrderBookView::on_events(std::span<const Event> events)
+{
+    std::lock_guard lock(mtx_);
+    for (const Event &e : events)
+        if (e.type == EventType::LevelAgg)
+            apply_level(e.d.level);
+}
 
+bool OrderBookView::on_gap(Seq, Seq)
+{
+    std::lock_guard lock(mtx_);
+    bid_levels_.clear();
+    ask_levels_.clear();
+    return true;
+}
+
+void OrderBookView::apply_level(const E_LevelAgg &lvl)
+{
     if (lvl.side == Order::Side::Buy)
     {
         if (lvl.aggQty > 0)
@@ -24,7 +43,7 @@ void OrderBookView::on_event(const Event &e)
     }
 }
 
-std::optional<int64_t> OrderBookView::get_qty_at_price(Order::Side side, double px) const
+std::optional<int64_t> OrderBookView::get_qty_at_price(Order::Side side, Price px) const
 {
     std::lock_guard lock(mtx_);
     if (side == Order::Side::Buy)
@@ -53,7 +72,7 @@ std::vector<PriceLevelView> OrderBookView::top_n(Order::Side side, size_t n) con
         size_t count = 0;
         for (const auto &[price, qty] : bid_levels_)
         {
-            result.push_back(PriceLevelView{price, 0, static_cast<uint32_t>(qty)});
+            result.push_back(PriceLevelView{price, 0, static_cast<uint64_t>(qty)});
             if (++count >= n)
                 break;
         }
@@ -63,7 +82,7 @@ std::vector<PriceLevelView> OrderBookView::top_n(Order::Side side, size_t n) con
         size_t count = 0;
         for (const auto &[price, qty] : ask_levels_)
         {
-            result.push_back(PriceLevelView{price, 0, static_cast<uint32_t>(qty)});
+            result.push_back(PriceLevelView{price, 0, static_cast<uint64_t>(qty)});
             if (++count >= n)
                 break;
         }
@@ -1,6 +1,8 @@
 #include "engine/listeners/StatsCollector.h"
 #include "engine/events/Events.h"
 
+#include <iterator>
+
 void StatsCollector::on_event(const Event &e)
 {
     switch (e.type)
@@ -12,9 +14,9 @@ void StatsCollector::on_event(const Event &e)
             TradeInfo ti{
                 e.d.fill.makerId, // uint64_t → ok
                 e.d.fill.takerId, // uint64_t → ok
-                e.d.fill.px,      // double → double, should be fine
+                e.d.fill.px,      // Price → Price (ticks)
                 e.d.fill.qty,     // int64_t → int64_t, should be fine
-                e.ts,             // uint32_t → double? or uint64_t in TradeInfo?
+                e.ts,             // ns, carried as is
                 e.seq             // sequence number already assigned by engine
             };
             trade_buffer_->push(ti);
@@ -44,21 +46,80 @@ void StatsCollector::on_event(const Event &e)
     }
 }
 
+void StatsCollector::on_events(std::span<const Event> events)
+{
+    uint64_t orders = 0, fills = 0, cancels = 0;
+    std::optional<Price> bid, ask;
+    TradeInfo trades[64];
+    size_t n_trades = 0;
+
+    auto flush_trades = [&]
+    {
+        if (trade_buffer_ && n_trades)
+            trade_buffer_->push_n(trades, n_trades);
+        n_trades = 0;
+    };
+
+    for (const Event &e : events)
+    {
+        switch (e.type)
+        {
+        case EventType::Fill:
+            ++fills;
+            if (trade_buffer_)
+            {
+                trades[n_trades++] = TradeInfo{e.d.fill.makerId, e.d.fill.takerId, e.d.fill.px,
+                                               e.d.fill.qty, e.ts, e.seq};
+                if (n_trades == std::size(trades))
+                    flush_trades();
+            }
+            break;
+        case EventType::OrderAdded:
+            ++orders;
+            break;
+        case EventType::OrderRemoved:
+            ++cancels;
+            break;
+        case EventType::LevelAgg:
+            (e.d.level.side == Order::Side::Buy ? bid : ask) = e.d.level.px;
+            break;
+        default:
+            break;
+        }
+    }
+    flush_trades();
+
+    if (orders)
+        total_orders_.fetch_add(orders, std::memory_order_relaxed);
+    if (fills)
+        total_fills_.fetch_add(fills, std::memory_order_relaxed);
+    if (cancels)
+        total_cancels_.fetch_add(cancels, std::memory_order_relaxed);
+    if (bid || ask)
+    {
+        std::lock_guard lock(mtx_);
+        if (bid)
+            best_bid_ = *bid;
+        if (ask)
+            best_ask_ = *ask;
+    }
+}
+
 double StatsCollector::average_spread() const
 {
     std::lock_guard lock(mtx_);
     if (best_bid_ == 0 || best_ask_ == 0)
         return 0.0;
-    return static_cast<double>(best_ask_ - best_bid_);
+    return DEFAULT_INSTRUMENT.to_price(best_ask_ - best_bid_);
 }
 
-std::optional<int64_t> StatsCollector::last_best_bid() const
+std::optional<Price> StatsCollector::last_best_bid() const
 {
     std::lock_guard lock(mtx_);
     return best_bid_ > 0 ? std::make_optional(best_bid_) : std::nullopt;
 }
 
-std::optional<int64_t> StatsCollector::last_best_ask() const
+std::optional<Price> StatsCollector::last_best_ask() const
 {
     std::lock_guard lock(mtx_);
     return best_ask_ > 0 ? std::make_optional(best_ask_) : std::nullopt;
@@ -1,64 +1,99 @@
 #include "engine/match/PriceTimePriorityStrategy.h"
-#include <algorithm> // std::min
+#include "engine/side/OrderBookSide.h"
+#include "engine/side/LadderBookSide.h"
 
-// Helper: price acceptance based on side/market
-static inline bool price_ok(const Order &incoming, double levelPrice)
+#include <functional>
+#include <vector>
+
+// Gives any IOrderBookSideView the visit_levels() shape match_side expects
+// (virtual calls + one copy of each level's order refs: tests/tooling only)
+struct VirtualSideVisitor
 {
-    if (incoming.isMarket())
-        return true;
-    return incoming.isBuy() ? (incoming.price >= levelPrice)
-                            : (incoming.price <= levelPrice);
-}
+    const IOrderBookSideView &view;
+
+    template <typename Fn>
+    void visit_levels(Fn &&fn) const
+    {
+        std::vector<std::reference_wrapper<const Order>> orders;
+        for (auto px = view.best_price(); px; px = view.next_price(*px))
+        {
+            orders.clear();
+            view.for_each_order_at_price(*px, [&](const Order &o)
+                                         { orders.emplace_back(o); });
+            if (!fn(*px, orders))
+                return;
+        }
+    }
+};
 
 MatchResult PriceTimePriorityStrategy::match(
     Order &incoming,
     const IOrderBookSideView &opposite_side,
     std::vector<FillOp> &out)
+{
+    // The backend tag names the concrete (final) side: a byte switch, not a
+    // chain of __dynamic_cast runtime calls
+    switch (opposite_side.backend())
+    {
+    case SideBackend::AskLadder:
+        return match_side(incoming, static_cast<const AskLadderSide &>(opposite_side), out);
+    case SideBackend::BidLadder:
+        return match_side(incoming, static_cast<const BidLadderSide &>(opposite_side), out);
+    case SideBackend::AskMap:
+        return match_side(incoming, static_cast<const AskBookSide &>(opposite_side), out);
+    case SideBackend::BidMap:
+        return match_side(incoming, static_cast<const BidBookSide &>(opposite_side), out);
+    case SideBackend::Other:
+        break;
+    }
+    return match_side(incoming, VirtualSideVisitor{opposite_side}, out);
+}
+
+template <typename SideView>
+MatchResult PriceTimePriorityStrategy::match_side(
+    Order &incoming,
+    const SideView &opposite_side,
+    std::vector<FillOp> &out)
 {
     MatchResult result{};
     if (incoming.quantity == 0)
         return result;
 
+    // Levels are walked best -> worse, stopping at the first price that no
+    // longer crosses (or once filled), so a sweep only touches the levels
+    // it consumes.
+
     // --- FOK pre-check: ensure full fillability before emitting any FillOps
-    if (incoming.isFOK())
+    if (incoming.isFOK() && !fully_fillable(incoming, opposite_side))
     {
-        uint64_t canFill = 0;
-        opposite_side.for_each_level([&](const PriceLevelView &lvl)
-                                     {
-            if (!price_ok(incoming, lvl.price) || canFill >= incoming.quantity) return;
-            opposite_side.for_each_order_at_price(lvl.price, [&](const Order& resting){
-                if (!price_ok(incoming, lvl.price) || canFill >= incoming.quantity) return;
-                canFill += resting.quantity;
-            }); });
-        if (canFill < incoming.quantity)
-        {
-            result.allOrNoneFailed = true;
-            return result; // no FillOps emitted
-        }
+        result.allOrNoneFailed = true;
+        return result; // no FillOps emitted
     }
 
     // --- Produce FillOps in FIFO order until filled or price no longer ok
     uint32_t remaining = incoming.quantity;
 
-    opposite_side.for_each_level([&](const PriceLevelView &lvl)
-                                 {
-        if (remaining == 0) return;
-        if (!price_ok(incoming, lvl.price)) return;
-
-        opposite_side.for_each_order_at_price(lvl.price, [&](const Order& resting) {
-            if (remaining == 0) return;
-
+    opposite_side.visit_levels([&](Price px, const auto &orders)
+                               {
+        if (!price_ok(incoming, px))
+            return false;
+        for (const Order &resting : orders)
+        {
             const uint32_t exec = static_cast<uint32_t>(std::min<uint64_t>(remaining, resting.quantity));
-            if (exec == 0) return;
+            if (exec == 0)
+                continue;
 
             out.push_back(FillOp{
                 /*makerOrderId*/ resting.id,
                 /*qty*/          exec,
-                /*price*/        lvl.price
+                /*price*/        px
             });
 
             remaining -= exec;
-        }); });
+            if (remaining == 0)
+                return false;
+        }
+        return true; });
 
     // Strategy can either leave mutation to engine or reflect planned fills:
     const uint32_t filled = incoming.quantity - remaining;
@@ -71,3 +106,9 @@ MatchResult PriceTimePriorityStrategy::match(
     // IOC is handled by engine: if remaining > 0 and IOC, engine cancels remainder.
     return result;
 }
+
+// Explicit instantiations
+template MatchResult PriceTimePriorityStrategy::match_side(Order &, const BidBookSide &, std::vector<FillOp> &);
+template MatchResult PriceTimePriorityStrategy::match_side(Order &, const AskBookSide &, std::vector<FillOp> &);
+template MatchResult PriceTimePriorityStrategy::match_side(Order &, const BidLadderSide &, std::vector<FillOp> &);
+template MatchResult PriceTimePriorityStrategy::match_side(Order &, const AskLadderSide &, std::vector<FillOp> &);
@@ -0,0 +1,27 @@
+#include "engine/side/DynamicBookSide.h"
+#include "engine/side/OrderBookSide.h"
+#include "engine/side/LadderBookSide.h"
+
+// Build the configured backend
+template <typename Compare>
+static std::unique_ptr<IOrderBookSide> make_book_side(OrderPool &pool, const OrderBookEngineConfig &config)
+{
+    switch (config.book_side)
+    {
+    case BookSideKind::Ladder:
+        return std::make_unique<LadderBookSide<Compare>>(pool, config.ladder_window_ticks, config.ladder_max_window_ticks);
+    case BookSideKind::Map:
+    default:
+        return std::make_unique<OrderBookSide<Compare>>(pool);
+    }
+}
+
+template <typename Compare>
+DynamicBookSide<Compare>::DynamicBookSide(OrderPool &pool, const OrderBookEngineConfig &config)
+    : impl_(make_book_side<Compare>(pool, config))
+{
+}
+
+// Explicit instantiations
+template class DynamicBookSide<utils::comparator::Ascending>;
+template class DynamicBookSide<utils::comparator::Descending>;
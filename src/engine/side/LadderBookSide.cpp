@@ -0,0 +1,293 @@
+#include "engine/side/LadderBookSide.h"
+#include "core/Order.h"
+#include "utils/log/DebugLog.h"
+
+#include <algorithm>
+
+template <typename Compare>
+LadderBookSide<Compare>::LadderBookSide(size_t window_ticks, size_t max_window_ticks)
+    : IOrderBookSide(BACKEND),
+      owned_pool_(std::make_unique<OrderPool>()),
+      pool_(*owned_pool_),
+      max_ticks_(std::max<size_t>(max_window_ticks, 1)),
+      levels_(make_levels(std::clamp<size_t>(window_ticks, 1, max_ticks_))),
+      occupied_(levels_.size())
+{
+}
+
+template <typename Compare>
+LadderBookSide<Compare>::LadderBookSide(OrderPool &pool, size_t window_ticks, size_t max_window_ticks)
+    : IOrderBookSide(BACKEND),
+      pool_(pool),
+      max_ticks_(std::max<size_t>(max_window_ticks, 1)),
+      levels_(make_levels(std::clamp<size_t>(window_ticks, 1, max_ticks_))),
+      occupied_(levels_.size())
+{
+}
+
+template <typename Compare>
+std::vector<typename LadderBookSide<Compare>::PriceLevel> LadderBookSide<Compare>::make_levels(size_t ticks)
+{
+    std::vector<PriceLevel> levels;
+    levels.reserve(ticks);
+    for (size_t i = 0; i < ticks; ++i)
+        levels.emplace_back(pool_);
+    return levels;
+}
+
+// ---- window management ----
+
+template <typename Compare>
+void LadderBookSide<Compare>::rebase(Price new_base, size_t new_ticks)
+{
+    DEBUG_ORDERBOOKSIDE("Ladder rebase base {} -> {} ticks {} -> {}", base_, new_base, levels_.size(), new_ticks);
+
+    std::vector<PriceLevel> levels = make_levels(new_ticks);
+    OccupancyBitmap occupied(new_ticks);
+    size_t best = NO_LEVEL;
+
+    for (size_t i = occupied_.first(); i != NO_LEVEL; i = occupied_.find_next(i + 1))
+    {
+        // moving a level keeps its pool nodes, so handles held by the engine stay valid
+        const size_t slot = static_cast<size_t>(base_ + static_cast<Price>(i) - new_base);
+        levels[slot] = std::move(levels_[i]);
+        occupied.set(slot);
+        if (i == best_)
+            best = slot;
+    }
+
+    levels_ = std::move(levels);
+    occupied_ = std::move(occupied);
+    base_ = new_base;
+    best_ = best;
+}
+
+template <typename Compare>
+void LadderBookSide<Compare>::recenter(Price center)
+{
+    const Price ticks = static_cast<Price>(levels_.size());
+    Price new_base = center - ticks / 2;
+
+    if (count_ > 0)
+    {
+        // keep every live level inside the window
+        const Price lo_px = base_ + static_cast<Price>(occupied_.first());
+        const Price hi_px = base_ + static_cast<Price>(occupied_.last());
+        if (lo_px < new_base)
+            new_base = lo_px;
+        if (hi_px >= new_base + ticks)
+            new_base = hi_px - ticks + 1;
+    }
+
+    if (new_base != base_)
+        rebase(new_base, levels_.size());
+}
+
+template <typename Compare>
+size_t LadderBookSide<Compare>::span_with(Price price) const
+{
+    if (count_ == 0)
+        return 1;
+    const Price lo_px = std::min(price, base_ + static_cast<Price>(occupied_.first()));
+    const Price hi_px = std::max(price, base_ + static_cast<Price>(occupied_.last()));
+    return static_cast<size_t>(hi_px - lo_px) + 1;
+}
+
+template <typename Compare>
+size_t LadderBookSide<Compare>::ensure_slot(Price price)
+{
+    if (in_window(price))
+        return slot_of(price);
+
+    size_t ticks = levels_.size();
+    if (count_ == 0)
+    {
+        rebase(price - static_cast<Price>(ticks / 2), ticks);
+        return slot_of(price);
+    }
+
+    // Live band including the new price; double the window until it fits
+    const size_t span = span_with(price);
+    if (span > max_ticks_)
+        return NO_LEVEL; // an outlier: growing to it would allocate the whole gap
+    while (span > ticks)
+        ticks *= 2;
+    ticks = std::min(ticks, max_ticks_);
+
+    const Price lo_px = std::min(price, base_ + static_cast<Price>(occupied_.first()));
+    rebase(lo_px - static_cast<Price>((ticks - span) / 2), ticks);
+    return slot_of(price);
+}
+
+template <typename Compare>
+void LadderBookSide<Compare>::mark_live(size_t slot)
+{
+    if (occupied_.test(slot))
+        return;
+    occupied_.set(slot);
+    ++count_;
+    if (best_ == NO_LEVEL || better(slot, best_))
+        best_ = slot;
+}
+
+template <typename Compare>
+void LadderBookSide<Compare>::release_slot(size_t slot)
+{
+    levels_[slot].clear();
+    occupied_.clear(slot);
+    --count_;
+    if (slot == best_)
+        best_ = next_live(slot);
+}
+
+// ---- mutators ----
+
+template <typename Compare>
+void LadderBookSide<Compare>::add_order(const Order &o)
+{
+    add_order_and_get_iterator(o);
+}
+
+template <typename Compare>
+typename LadderBookSide<Compare>::OrderList::iterator
+LadderBookSide<Compare>::add_order_and_get_iterator(const Order &o)
+{
+    const size_t slot = ensure_slot(o.price);
+    if (slot == NO_LEVEL)
+        return no_level_.end();
+    auto it = levels_[slot].push_back(o);
+    mark_live(slot);
+    return it;
+}
+
+template <typename Compare>
+bool LadderBookSide<Compare>::accepts_price(Price price) const
+{
+    return in_window(price) || span_with(price) <= max_ticks_;
+}
+
+template <typename Compare>
+typename LadderBookSide<Compare>::OrderList &
+LadderBookSide<Compare>::get_orders_at_price(Price price)
+{
+    // resting orders are always inside the window; anything else has none
+    if (!in_window(price))
+        return no_level_;
+    return levels_[slot_of(price)];
+}
+
+template <typename Compare>
+const typename LadderBookSide<Compare>::OrderList &
+LadderBookSide<Compare>::get_orders_at_price(Price price) const
+{
+    static const OrderList empty_list{}; // safe empty reference
+
+    if (!in_window(price))
+        return empty_list;
+    return levels_[slot_of(price)];
+}
+
+template <typename Compare>
+void LadderBookSide<Compare>::remove_price_level(Price price)
+{
+    if (!in_window(price))
+        return;
+    const size_t slot = slot_of(price);
+    if (!occupied_.test(slot))
+        return;
+
+    release_slot(slot);
+}
+
+template <typename Compare>
+bool LadderBookSide<Compare>::empty_at_price(Price price) const
+{
+    return !in_window(price) || levels_[slot_of(price)].empty();
+}
+
+// ---- IOrderBookSideView ----
+
+template <typename Compare>
+std::optional<Price> LadderBookSide<Compare>::best_price() const
+{
+    if (best_ == NO_LEVEL)
+        return std::nullopt;
+    return base_ + static_cast<Price>(best_);
+}
+
+template <typename Compare>
+std::optional<Price> LadderBookSide<Compare>::next_price(Price price) const
+{
+    size_t next;
+    if (in_window(price))
+        next = next_live(slot_of(price));
+    else if ((price < base_) == HIGH_IS_BEST)
+        return std::nullopt; // already past the worst slot
+    else
+        next = HIGH_IS_BEST ? occupied_.last() : occupied_.first();
+
+    if (next == NO_LEVEL)
+        return std::nullopt;
+    return base_ + static_cast<Price>(next);
+}
+
+template <typename Compare>
+size_t LadderBookSide<Compare>::num_levels() const
+{
+    return count_;
+}
+
+template <typename Compare>
+void LadderBookSide<Compare>::for_each_level(const std::function<void(const PriceLevelView &)> &fn) const
+{
+    visit_levels([&](Price price, const OrderList &orders)
+                 { fn(PriceLevelView{price, orders.size(), orders.aggregate_qty()}); return true; });
+}
+
+template <typename Compare>
+void LadderBookSide<Compare>::for_each_order_at_price(
+    Price price, const std::function<void(const Order &)> &fn) const
+{
+    visit_orders(price, [&](const Order &o)
+                 { fn(o); return true; });
+}
+
+// ---- side_tag specializations ----
+
+template <>
+constexpr Order::Side LadderBookSide<utils::comparator::Descending>::side_tag()
+{
+    return Order::Side::Buy;
+}
+
+template <>
+constexpr Order::Side LadderBookSide<utils::comparator::Ascending>::side_tag()
+{
+    return Order::Side::Sell;
+}
+
+// ---- Event Handling (read-only, same as the map backend) ----
+
+template <typename Compare>
+void LadderBookSide<Compare>::on_event(const Event &e)
+{
+    switch (e.type)
+    {
+    case EventType::OrderAdded:
+        if (e.d.added.side == side_tag())
+            DEBUG_ORDERBOOKSIDE("Ladder listener saw OrderAdded: {}", e.d.added);
+        break;
+    case EventType::OrderRemoved:
+        DEBUG_ORDERBOOKSIDE("Ladder listener saw OrderRemoved: id={}", e.d.removed.id);
+        break;
+    case EventType::Fill:
+        DEBUG_ORDERBOOKSIDE("Ladder listener saw Fill: {}", e.d.fill);
+        break;
+    default:
+        break;
+    }
+}
+
+// Explicit instantiations
+template class LadderBookSide<utils::comparator::Ascending>;
+template class LadderBookSide<utils::comparator::Descending>;
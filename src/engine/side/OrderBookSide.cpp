@@ -2,31 +2,41 @@
 #include "core/Order.h"
 #include "utils/log/DebugLog.h"
 
+template <typename Compare>
+OrderBookSide<Compare>::OrderBookSide()
+    : IOrderBookSide(BACKEND), owned_pool_(std::make_unique<OrderPool>()), pool_(*owned_pool_)
+{
+}
+
+template <typename Compare>
+OrderBookSide<Compare>::OrderBookSide(OrderPool &pool)
+    : IOrderBookSide(BACKEND), pool_(pool)
+{
+}
+
 template <typename Compare>
 void OrderBookSide<Compare>::add_order(const Order &o)
 {
-    price_levels_[o.price].push_back(o);
+    level_at(o.price).push_back(o);
 }
 
 template <typename Compare>
 typename OrderBookSide<Compare>::OrderList::iterator
 OrderBookSide<Compare>::add_order_and_get_iterator(const Order &o)
 {
-    auto &orders = price_levels_[o.price]; // inserts if not exists
-    orders.push_back(o);
-    return std::prev(orders.end());
+    return level_at(o.price).push_back(o);
 }
 
 template <typename Compare>
 typename OrderBookSide<Compare>::OrderList &
-OrderBookSide<Compare>::get_orders_at_price(double price)
+OrderBookSide<Compare>::get_orders_at_price(Price price)
 {
-    return price_levels_[price]; // inserts if not exists
+    return level_at(price);
 }
 
 template <typename Compare>
 const typename OrderBookSide<Compare>::OrderList &
-OrderBookSide<Compare>::get_orders_at_price(double price) const
+OrderBookSide<Compare>::get_orders_at_price(Price price) const
 {
     static const OrderList empty_list{}; // safe empty reference
 
@@ -37,13 +47,22 @@ OrderBookSide<Compare>::get_orders_at_price(double price) const
 }
 
 template <typename Compare>
-std::optional<double> OrderBookSide<Compare>::best_price() const
+std::optional<Price> OrderBookSide<Compare>::best_price() const
 {
     if (price_levels_.empty())
         return std::nullopt;
     return price_levels_.begin()->first;
 }
 
+template <typename Compare>
+std::optional<Price> OrderBookSide<Compare>::next_price(Price price) const
+{
+    auto it = price_levels_.upper_bound(price); // first level worse than price
+    if (it == price_levels_.end())
+        return std::nullopt;
+    return it->first;
+}
+
 template <typename Compare>
 size_t OrderBookSide<Compare>::num_levels() const
 {
@@ -53,38 +72,26 @@ size_t OrderBookSide<Compare>::num_levels() const
 template <typename Compare>
 void OrderBookSide<Compare>::for_each_level(const std::function<void(const PriceLevelView &)> &fn) const
 {
-    for (const auto &[price, orders] : price_levels_)
-    {
-        uint64_t agg_qty = 0;
-        for (const auto &o : orders)
-        {
-            agg_qty += o.quantity; // consider effective_qty(o) later
-        }
-        fn(PriceLevelView{price, agg_qty});
-    }
+    visit_levels([&](Price price, const OrderList &orders)
+                 { fn(PriceLevelView{price, orders.size(), orders.aggregate_qty()}); return true; });
 }
 
 template <typename Compare>
 void OrderBookSide<Compare>::for_each_order_at_price(
-    double price, const std::function<void(const Order &)> &fn) const
+    Price price, const std::function<void(const Order &)> &fn) const
 {
-    auto it = price_levels_.find(price);
-    if (it == price_levels_.end())
-        return;
-    for (const auto &o : it->second)
-    {
-        fn(o);
-    }
+    visit_orders(price, [&](const Order &o)
+                 { fn(o); return true; });
 }
 
 template <typename Compare>
-void OrderBookSide<Compare>::remove_price_level(double price)
+void OrderBookSide<Compare>::remove_price_level(Price price)
 {
     price_levels_.erase(price);
 }
 
 template <typename Compare>
-bool OrderBookSide<Compare>::empty_at_price(double price) const
+bool OrderBookSide<Compare>::empty_at_price(Price price) const
 {
     auto it = price_levels_.find(price);
     return it == price_levels_.end() || it->second.empty();
@@ -7,21 +7,40 @@
 
 #include <iostream>
 
-MarketSimulator::MarketSimulator()
-    : engine_(bus_)
+// Feeders quote a band of a few hundred ticks: dense ladder window
+static OrderBookEngineConfig simulator_engine_config()
+{
+    OrderBookEngineConfig config;
+    config.ladder_window_ticks = 1024;
+    return config;
+}
+
+unsigned int MarketSimulator::feeder_count()
 {
     unsigned int num_cores = std::thread::hardware_concurrency();
-    unsigned int num_feeders = (num_cores > 1) ? (num_cores - 1) : 1;
+    return (num_cores > 1) ? (num_cores - 1) : 1;
+}
+
+MarketSimulator::MarketSimulator(WaitStrategy engine_wait)
+    : ingress_(feeder_count(), LANE_CAPACITY), engine_wait_(engine_wait),
+      engine_(bus_, PriceTimePriorityStrategy{}, simulator_engine_config())
+{
+    const unsigned int num_feeders = static_cast<unsigned int>(ingress_.lane_count());
     feeders_.reserve(num_feeders);
 
     for (unsigned int i = 0; i < num_feeders; ++i)
     {
         auto rng = std::make_shared<RealRNG>();
         feeders_.emplace_back(std::make_unique<MarketFeeder>(
-            order_queue_, rng, i + 1, num_feeders * 100));
+            ingress_.lane(i), rng, i + 1, num_feeders * 100));
     }
 }
 
+MarketSimulator::~MarketSimulator()
+{
+    stop();
+}
+
 void MarketSimulator::start()
 {
     running_ = true;
@@ -36,25 +55,43 @@ void MarketSimulator::start()
 
 void MarketSimulator::stop()
 {
-    running_ = false;
-
+    // Feeders first: their lanes close, so everything already queued becomes drainable
     for (auto &feeder : feeders_)
         feeder->stop();
 
+    running_ = false;
+    ingress_.doorbell().wake_all(); // a parked engine rechecks running_
+
     if (engine_thread_.joinable())
         engine_thread_.join();
 }
 
 void MarketSimulator::engine_loop()
 {
+    std::vector<Order> batch;
+    batch.reserve(ENGINE_BATCH_SIZE);
+    IdleWaiter waiter(engine_wait_, &ingress_.doorbell());
+    auto wake = [this]
+    { return ingress_.ready() || !running_.load(std::memory_order_relaxed); };
+
     while (running_)
     {
-        // Pop next order from the queue
-        Order order = order_queue_.wait_and_pop();
+        // Merge the feeder lanes in timestamp order (up to a batch), lock-free
+        batch.clear();
+        if (ingress_.drain(batch, ENGINE_BATCH_SIZE) == 0)
+        {
+            waiter.idle(wake);
+            continue;
+        }
+        waiter.reset();
 
-        // Add order to engine (triggers matching, events published)
-        engine_.add_order(order);
+        // Add orders to engine (matching; events published per batch)
+        engine_.add_orders(batch);
     }
+
+    // Shutdown: match what the stopped feeders left in their lanes
+    for (batch.clear(); ingress_.drain(batch, ENGINE_BATCH_SIZE) != 0; batch.clear())
+        engine_.add_orders(batch);
 }
 
 // MarketSimulator
@@ -75,17 +112,24 @@ void MarketSimulator::enable_live_view(bool enable)
     {
         // Core listeners (data, not UI)
         auto trade_buffer = std::make_shared<TradeBuffer>(1024);
-        auto live_orderbook = make_and_add_listener_to_bus<OrderBookView>(live_view_listeners_);
-        auto live_stats = make_and_add_listener_to_bus<StatsCollector>(live_view_listeners_, trade_buffer);
+        // The book view only needs each level's latest size: conflate rather than stall the engine
+        auto live_orderbook = make_and_add_listener_to_bus<OrderBookView>(live_view_listeners_,
+                                                                          ListenerOptions{.bp = Backpressure::Conflate});
+        auto live_stats = make_and_add_listener_to_bus<StatsCollector>(live_view_listeners_, ListenerOptions{}, trade_buffer);
 
         // Dashboard + views (dashboard owns these views)
         auto dashboard = std::make_unique<Dashboard>();
         dashboard->add_view(std::make_unique<OrderBookViewRenderer>(live_orderbook));
         dashboard->add_view(std::make_unique<StatsViewRenderer>(live_stats));
-        dashboard->add_view(std::make_unique<TradesViewRenderer>(trade_buffer, engine_.tick_wall_times(), 5));
+        dashboard->add_view(std::make_unique<TradesViewRenderer>(trade_buffer, 5));
 
         // Publisher (wraps dashboard, connects to bus, owns dashboard)
-        make_and_add_listener_to_bus<MarketDataPublisher>(live_view_listeners_, std::move(dashboard));
+        // Terminal rendering is slow (it sleeps between frames): a gating cursor here
+        // would fill the ring and stall the engine, so drop instead and run on its own
+        // thread to keep the pool free. Missed fills only delay the next redraw.
+        make_and_add_listener_to_bus<MarketDataPublisher>(
+            live_view_listeners_, ListenerOptions{.bp = Backpressure::Drop, .dispatch = Dispatch::Dedicated},
+            std::move(dashboard));
     }
     else if (!enable && !live_view_listeners_.empty())
     {
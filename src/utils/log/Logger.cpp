@@ -11,7 +11,7 @@ void Logger::on_event(const Event &e)
         break;
     case EventType::OrderUpdated:
         std::cout << std::format("[OrderUpdated] ID:{} Price:{:.2f} Qty:{}",
-                                 e.d.updated.id, e.d.updated.px, e.d.updated.qty)
+                                 e.d.updated.id, DEFAULT_INSTRUMENT.to_price(e.d.updated.px), e.d.updated.qty)
                   << "\n";
         break;
     case EventType::OrderRemoved:
@@ -0,0 +1,20 @@
+#include "utils/time/IClock.h"
+#include "utils/time/MonotonicClock.h"
+#include "utils/time/TscClock.h"
+
+IClock &default_clock()
+{
+    // Calibrated once, on first use (thread-safe static init)
+    static IClock &clock = []() -> IClock &
+    {
+        if (TscClock::invariant_tsc())
+        {
+            static TscClock tsc;
+            if (tsc.uses_tsc())
+                return tsc;
+        }
+        static MonotonicClock monotonic;
+        return monotonic;
+    }();
+    return clock;
+}
@@ -0,0 +1,78 @@
+#include "utils/time/TscClock.h"
+
+#if TSC_CLOCK_AVAILABLE
+#include <cpuid.h>
+#endif
+
+namespace
+{
+#if TSC_CLOCK_AVAILABLE
+    // One (tsc, ns) pair: the MonotonicClock read bracketed by rdtscp, keeping
+    // the tightest of a few tries so preemption does not skew the pair
+    struct Sample
+    {
+        uint64_t tsc;
+        Timestamp ns;
+    };
+
+    Sample sample()
+    {
+        Sample best{};
+        uint64_t best_width = UINT64_MAX;
+        unsigned aux;
+        for (int i = 0; i < 8; ++i)
+        {
+            const uint64_t t0 = __rdtscp(&aux);
+            const Timestamp ns = MonotonicClock::read();
+            const uint64_t t1 = __rdtscp(&aux);
+            if (t1 - t0 < best_width)
+            {
+                best_width = t1 - t0;
+                best = {t0 + (t1 - t0) / 2, ns};
+            }
+        }
+        return best;
+    }
+#endif
+}
+
+TscClock::TscClock(std::chrono::nanoseconds calibration)
+{
+    if (invariant_tsc())
+        calibrate(calibration);
+}
+
+bool TscClock::invariant_tsc()
+{
+#if TSC_CLOCK_AVAILABLE
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007)
+        return false;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx))
+        return false;
+    return (edx >> 8) & 1; // advanced power management: invariant TSC
+#else
+    return false;
+#endif
+}
+
+void TscClock::calibrate(std::chrono::nanoseconds span)
+{
+#if TSC_CLOCK_AVAILABLE
+    const Sample a = sample();
+    const Timestamp until = a.ns + static_cast<Timestamp>(span.count());
+    while (MonotonicClock::read() < until)
+        ; // spin: sleeping adds nothing, the bracket reads are what count
+    const Sample b = sample();
+
+    if (b.tsc <= a.tsc || b.ns <= a.ns)
+        return; // counter not moving: stay on MonotonicClock
+
+    mult_ = static_cast<uint64_t>((static_cast<unsigned __int128>(b.ns - a.ns) << SHIFT) / (b.tsc - a.tsc));
+    base_tsc_ = b.tsc;
+    base_ns_ = b.ns;
+    use_tsc_ = mult_ != 0;
+#else
+    (void)span;
+#endif
+}
@@ -1,5 +1,4 @@
 #include <gtest/gtest.h>
-#include "utils/data_structures/ThreadSafeQueue.h"
 #include "utils/random/RealRNG.h"
 #include "core/MarketFeeder.h"
 #include "utils/random/MockRNG.h"
@@ -8,79 +7,77 @@
 #include <unordered_set>
 #include <thread>
 #include <chrono>
+#include <vector>
+
+// Everything the feeders' lanes hold, in merge order (call after stop())
+static std::vector<Order> drain_all(OrderIngress &ingress)
+{
+    std::vector<Order> out;
+    ingress.drain(out, SIZE_MAX);
+    return out;
+}
 
 TEST(MarketFeederTest, FeedsOrdersIntoQueue)
 {
-    ThreadSafeQueue<Order> queue;
+    OrderIngress ingress(1, 1 << 16);
     auto rng = std::make_shared<RealRNG>(42); // seeded for deterministic
-    MarketFeeder feeder(queue, rng);
+    MarketFeeder feeder(ingress.lane(0), rng);
     feeder.start();
 
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
     feeder.stop();
 
-    int count = 0;
-    while (auto order = queue.pop())
+    auto orders = drain_all(ingress);
+    for (const auto &order : orders)
     {
-        EXPECT_GE(order->price, 0.0);
-        EXPECT_GT(order->quantity, 0u);
-        EXPECT_TRUE(order.value().isBuy() || order.value().isSell());
-        ++count;
+        EXPECT_GE(order.price, 0);
+        EXPECT_GT(order.quantity, 0u);
+        EXPECT_TRUE(order.isBuy() || order.isSell());
     }
-    EXPECT_GT(count, 0);
+    EXPECT_GT(orders.size(), 0u);
 }
 
 TEST(MarketFeederTest, StopsGracefully)
 {
-    ThreadSafeQueue<Order> queue;
+    OrderIngress ingress(1, 1 << 16);
     auto rng = std::make_shared<RealRNG>(123);
-    MarketFeeder feeder(queue, rng);
+    MarketFeeder feeder(ingress.lane(0), rng);
     feeder.start();
 
     std::this_thread::sleep_for(std::chrono::milliseconds(50));
     feeder.stop();
 
     std::this_thread::sleep_for(std::chrono::milliseconds(50));
-    int current_size = 0;
-    while (queue.pop())
-        ++current_size;
+    drain_all(ingress);
 
     std::this_thread::sleep_for(std::chrono::milliseconds(50));
-    int after_stop_count = 0;
-    while (queue.pop())
-        ++after_stop_count;
-
-    EXPECT_EQ(after_stop_count, 0);
+    EXPECT_EQ(drain_all(ingress).size(), 0u);
 }
 
 TEST(MarketFeederTest, RapidStartStop)
 {
-    ThreadSafeQueue<Order> queue;
+    OrderIngress ingress(1, 1 << 16);
     auto rng = std::make_shared<RealRNG>();
     for (int i = 0; i < 10; ++i)
     {
-        MarketFeeder feeder(queue, rng);
+        MarketFeeder feeder(ingress.lane(0), rng);
         feeder.start();
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
         feeder.stop();
     }
 
-    int count = 0;
-    while (queue.pop())
-        ++count;
-
-    EXPECT_GT(count, 0);
+    EXPECT_GT(drain_all(ingress).size(), 0u);
 }
 
-TEST(MarketFeederTest, MultipleFeedersToSameQueue)
+TEST(MarketFeederTest, MultipleFeedersMergeInTimestampOrder)
 {
-    ThreadSafeQueue<Order> queue;
+    OrderIngress ingress(4, 1 << 14);
     std::vector<std::unique_ptr<MarketFeeder>> feeders;
 
     for (int i = 0; i < 4; ++i)
     {
         auto rng = std::make_shared<RealRNG>(i);
-        feeders.push_back(std::make_unique<MarketFeeder>(queue, rng));
+        feeders.push_back(std::make_unique<MarketFeeder>(ingress.lane(i), rng, i + 1));
         feeders.back()->start();
     }
 
@@ -88,88 +85,81 @@ TEST(MarketFeederTest, MultipleFeedersToSameQueue)
     for (auto &f : feeders)
         f->stop();
 
-    int count = 0;
-    while (queue.pop())
-        ++count;
-
-    EXPECT_GT(count, 10);
+    auto orders = drain_all(ingress);
+    EXPECT_GT(orders.size(), 10u);
+    for (size_t i = 1; i < orders.size(); ++i)
+        EXPECT_LE(orders[i - 1].timestamp, orders[i].timestamp);
 }
 
 TEST(MarketFeederTest, NoOrdersAfterImmediateStop)
 {
-    ThreadSafeQueue<Order> queue;
+    OrderIngress ingress(1, 1 << 16);
     auto rng = std::make_shared<RealRNG>();
-    MarketFeeder feeder(queue, rng);
+    MarketFeeder feeder(ingress.lane(0), rng);
     feeder.start();
     feeder.stop();
+    drain_all(ingress); // what it produced before stop() returned depends on scheduling
 
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
-    int count = 0;
-    while (queue.pop())
-        ++count;
-
-    EXPECT_LE(count, 2);
+    EXPECT_TRUE(drain_all(ingress).empty()); // nothing once stopped
 }
 
 TEST(MarketFeederTest, UniqueOrderIDs)
 {
-    ThreadSafeQueue<Order> queue;
+    OrderIngress ingress(1, 1 << 16);
     auto rng = std::make_shared<RealRNG>();
-    MarketFeeder feeder(queue, rng);
+    MarketFeeder feeder(ingress.lane(0), rng);
     feeder.start();
 
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
     feeder.stop();
 
     std::unordered_set<uint64_t> ids;
-    while (auto order = queue.pop())
+    for (const auto &order : drain_all(ingress))
     {
-        EXPECT_TRUE(ids.insert(order->id).second);
+        EXPECT_TRUE(ids.insert(order.id).second);
     }
 }
 
 TEST(MarketFeederTest, StressTestRunsLonger)
 {
-    ThreadSafeQueue<Order> queue;
+    OrderIngress ingress(1, 1 << 16);
     auto rng = std::make_shared<RealRNG>();
-    MarketFeeder feeder(queue, rng);
+    MarketFeeder feeder(ingress.lane(0), rng);
     feeder.start();
 
     std::this_thread::sleep_for(std::chrono::milliseconds(1200));
     feeder.stop();
 
-    int count = 0;
-    while (queue.pop())
-        ++count;
-
-    EXPECT_GT(count, 100);
+    EXPECT_GT(drain_all(ingress).size(), 100u);
 }
 
 TEST(MarketFeederMockTest, ProducesOrdersWithMockedPriceAndQuantity)
 {
     using Side = Order::Side;
-    ThreadSafeQueue<Order> queue;
+    OrderIngress ingress(1, 1 << 16);
 
     // Use factory parameters directly
     std::shared_ptr<MockRNG> mock_rng = make_mock_rng_from_factory_params({{100.25, 50, Side::Sell}});
 
-    MarketFeeder feeder(queue, mock_rng);
+    MarketFeeder feeder(ingress.lane(0), mock_rng);
     feeder.start();
     std::this_thread::sleep_for(std::chrono::milliseconds(1));
     feeder.stop();
 
-    auto order = queue.wait_and_pop();
-    // ASSERT_TRUE(order);
+    auto orders = drain_all(ingress);
+    ASSERT_FALSE(orders.empty());
+    const Order &order = orders.front();
     EXPECT_TRUE(order.isSell());
     EXPECT_EQ(order.quantity, 50u);
-    EXPECT_DOUBLE_EQ(order.price, 100.25);
+    EXPECT_EQ(order.price, to_ticks(100.25));
 }
 
 TEST(MarketFeederMockTest, AlternatesBuyAndSellSides)
 {
     using Side = Order::Side;
-    ThreadSafeQueue<Order> queue;
+    OrderIngress ingress(1, 1 << 16);
 
     // Factory parameters for 4 orders: Buy, Sell, Buy, Sell
     std::vector<std::tuple<double, uint32_t, Side>> orders = {
@@ -179,7 +169,7 @@ TEST(MarketFeederMockTest, AlternatesBuyAndSellSides)
         {80.0, 20, Side::Sell}};
 
     std::shared_ptr<MockRNG> mock_rng = make_mock_rng_from_factory_params(orders);
-    MarketFeeder feeder(queue, mock_rng);
+    MarketFeeder feeder(ingress.lane(0), mock_rng);
     feeder.start();
     std::this_thread::sleep_for(std::chrono::milliseconds(1));
     feeder.stop();
@@ -188,12 +178,12 @@ TEST(MarketFeederMockTest, AlternatesBuyAndSellSides)
     std::vector<double> expected_prices = {50.0, 60.0, 70.0, 80.0};
     std::vector<unsigned> expected_quantities = {5, 10, 15, 20};
 
+    auto produced = drain_all(ingress);
+    ASSERT_GE(produced.size(), expected_sides.size());
     for (size_t i = 0; i < expected_sides.size(); ++i)
     {
-        auto order = queue.pop();
-        ASSERT_TRUE(order);
-        EXPECT_EQ(order.value().side(), expected_sides[i]);
-        EXPECT_DOUBLE_EQ(order.value().price, expected_prices[i]);
-        EXPECT_EQ(order->quantity, expected_quantities[i]);
+        EXPECT_EQ(produced[i].side(), expected_sides[i]);
+        EXPECT_EQ(produced[i].price, to_ticks(expected_prices[i]));
+        EXPECT_EQ(produced[i].quantity, expected_quantities[i]);
     }
 }
\ No newline at end of file
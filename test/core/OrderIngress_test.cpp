@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include "core/OrderIngress.h"
+
+#include <vector>
+
+static Order make_order(uint64_t id, uint32_t ts)
+{
+    Order o{};
+    o.id = id;
+    o.timestamp = ts;
+    o.quantity = 1;
+    return o;
+}
+
+static std::vector<uint64_t> ids_of(const std::vector<Order> &orders)
+{
+    std::vector<uint64_t> ids;
+    for (const auto &o : orders)
+        ids.push_back(o.id);
+    return ids;
+}
+
+TEST(OrderIngressTest, MergesClosedLanesByTimestampThenLaneIndex)
+{
+    OrderIngress ingress(3, 16);
+    for (size_t i = 0; i < 3; ++i)
+        ingress.lane(i).open(0);
+
+    ingress.lane(0).try_push(make_order(1, 10));
+    ingress.lane(0).try_push(make_order(2, 30));
+    ingress.lane(1).try_push(make_order(3, 20));
+    ingress.lane(1).try_push(make_order(4, 30));
+    ingress.lane(2).try_push(make_order(5, 10));
+
+    for (size_t i = 0; i < 3; ++i)
+        ingress.lane(i).close();
+
+    std::vector<Order> out;
+    EXPECT_EQ(ingress.drain(out, 16), 5u);
+    // equal timestamps: lower lane index first
+    EXPECT_EQ(ids_of(out), (std::vector<uint64_t>{1, 5, 3, 2, 4}));
+}
+
+TEST(OrderIngressTest, IdleOpenLaneHoldsBackNewerOrders)
+{
+    OrderIngress ingress(2, 16);
+    ingress.lane(0).open(0);
+    ingress.lane(1).open(15); // idle feeder: nothing older than 15 will follow
+
+    ingress.lane(0).try_push(make_order(1, 10));
+    ingress.lane(0).try_push(make_order(2, 20));
+
+    std::vector<Order> out;
+    EXPECT_EQ(ingress.drain(out, 16), 1u); // 20 may still be preceded by lane 1
+    EXPECT_EQ(out.front().id, 1u);
+
+    ingress.lane(1).try_push(make_order(3, 18));
+    ingress.lane(1).close();
+    EXPECT_EQ(ingress.drain(out, 16), 2u);
+    EXPECT_EQ(ids_of(out), (std::vector<uint64_t>{1, 3, 2}));
+}
+
+TEST(OrderIngressTest, DrainRespectsMaxAndResumes)
+{
+    OrderIngress ingress(1, 16);
+    ingress.lane(0).open(0);
+    for (uint32_t i = 0; i < 5; ++i)
+        ingress.lane(0).try_push(make_order(i, i));
+    ingress.lane(0).close();
+
+    std::vector<Order> out;
+    EXPECT_EQ(ingress.drain(out, 3), 3u);
+    EXPECT_EQ(ingress.drain(out, 3), 2u);
+    EXPECT_EQ(ingress.drain(out, 3), 0u);
+    EXPECT_EQ(ids_of(out), (std::vector<uint64_t>{0, 1, 2, 3, 4}));
+}
+
+TEST(OrderIngressTest, FullLaneRejectsPush)
+{
+    OrderIngress ingress(1, 2);
+    ingress.lane(0).open(0);
+    EXPECT_TRUE(ingress.lane(0).try_push(make_order(1, 1)));
+    EXPECT_TRUE(ingress.lane(0).try_push(make_order(2, 2)));
+    EXPECT_FALSE(ingress.lane(0).try_push(make_order(3, 3)));
+}
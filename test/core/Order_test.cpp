@@ -16,7 +16,7 @@ TEST(OrderTest, FieldAssignment)
 
     EXPECT_EQ(order.id, 1);
     EXPECT_EQ(order.side(), Side::Buy);
-    EXPECT_DOUBLE_EQ(order.price, 100.0);
+    EXPECT_EQ(order.price, to_ticks(100.0));
     EXPECT_EQ(order.quantity, 10u);
     EXPECT_EQ(order.timestamp, 123456789u);
     EXPECT_TRUE(order.isIOC());
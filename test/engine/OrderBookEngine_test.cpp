@@ -4,12 +4,27 @@
 #include "test_utils/OrderFactory.h"
 #include "engine/events/EventBus.h"
 #include "utils/log/Logger.h"
+#include "utils/time/ManualClock.h"
 
-class OrderBookEngineTest : public ::testing::Test
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+// Every engine test runs against both book-side backends
+class OrderBookEngineTest : public ::testing::TestWithParam<BookSideKind>
 {
 protected:
+    static OrderBookEngineConfig make_config()
+    {
+        OrderBookEngineConfig config;
+        config.book_side = GetParam();
+        config.ladder_window_ticks = 16; // small window: exercise recentering/growth
+        return config;
+    }
+
     OrderBookEngineTest()
-        : engine(bus, std::make_unique<PriceTimePriorityStrategy>())
+        : engine(bus, std::make_unique<PriceTimePriorityStrategy>(), make_config())
     {
         bus.add_listener([&](const Event &e)
                          { logger.on_event(e); }, Backpressure::Drop);
@@ -19,9 +34,14 @@ protected:
     OrderBookEngine engine;
 };
 
+INSTANTIATE_TEST_SUITE_P(BookSides, OrderBookEngineTest,
+                         ::testing::Values(BookSideKind::Map, BookSideKind::Ladder),
+                         [](const auto &info)
+                         { return info.param == BookSideKind::Map ? "Map" : "Ladder"; });
+
 // --- Basic add/cancel tests ---
 
-TEST_F(OrderBookEngineTest, AddOrderAddsToCorrectSide)
+TEST_P(OrderBookEngineTest, AddOrderAddsToCorrectSide)
 {
     auto buy = TestOrderFactory::CreateBuy(1, 100.0, 10);
     auto sell = TestOrderFactory::CreateSell(2, 101.0, 5);
@@ -33,13 +53,13 @@ TEST_F(OrderBookEngineTest, AddOrderAddsToCorrectSide)
     auto best_ask = engine.asks().best_price();
 
     ASSERT_TRUE(best_bid.has_value());
-    EXPECT_DOUBLE_EQ(best_bid.value(), 100.0);
+    EXPECT_EQ(best_bid.value(), to_ticks(100.0));
 
     ASSERT_TRUE(best_ask.has_value());
-    EXPECT_DOUBLE_EQ(best_ask.value(), 101.0);
+    EXPECT_EQ(best_ask.value(), to_ticks(101.0));
 }
 
-TEST_F(OrderBookEngineTest, CancelOrderRemovesOrder)
+TEST_P(OrderBookEngineTest, CancelOrderRemovesOrder)
 {
     auto buy = TestOrderFactory::CreateBuy(1, 100.0, 10);
     engine.add_order(buy);
@@ -52,7 +72,7 @@ TEST_F(OrderBookEngineTest, CancelOrderRemovesOrder)
 
 // --- Matching tests (PriceTimePriorityStrategy) ---
 
-TEST_F(OrderBookEngineTest, BuyMatchesSellFIFO)
+TEST_P(OrderBookEngineTest, BuyMatchesSellFIFO)
 {
     // Arrange sells
     auto sells = {
@@ -69,14 +89,14 @@ TEST_F(OrderBookEngineTest, BuyMatchesSellFIFO)
     // Assert resting book
     auto best_ask = engine.asks().best_price();
     ASSERT_TRUE(best_ask.has_value());
-    EXPECT_DOUBLE_EQ(best_ask.value(), 100.0); // partially filled sell #2
+    EXPECT_EQ(best_ask.value(), to_ticks(100.0)); // partially filled sell #2
 
     // Check quantities
     // Sell #1 gone, Sell #2 partially
-    EXPECT_EQ(engine.asks().get_orders_at_price(100.0).front().quantity, 3);
+    EXPECT_EQ(engine.asks().get_orders_at_price(to_ticks(100.0)).front().quantity, 3);
 }
 
-TEST_F(OrderBookEngineTest, NoMatchIfPricesDontCross)
+TEST_P(OrderBookEngineTest, NoMatchIfPricesDontCross)
 {
     auto sell = TestOrderFactory::CreateSell(1, 102.0, 10);
     engine.add_order(sell);
@@ -87,15 +107,15 @@ TEST_F(OrderBookEngineTest, NoMatchIfPricesDontCross)
     // Incoming stays on bid side
     auto best_bid = engine.bids().best_price();
     ASSERT_TRUE(best_bid.has_value());
-    EXPECT_DOUBLE_EQ(best_bid.value(), 100.0);
+    EXPECT_EQ(best_bid.value(), to_ticks(100.0));
 
     // Sell untouched
     auto best_ask = engine.asks().best_price();
     ASSERT_TRUE(best_ask.has_value());
-    EXPECT_DOUBLE_EQ(best_ask.value(), 102.0);
+    EXPECT_EQ(best_ask.value(), to_ticks(102.0));
 }
 
-TEST_F(OrderBookEngineTest, BuyPartialFill)
+TEST_P(OrderBookEngineTest, BuyPartialFill)
 {
     // Resting sell order larger than incoming buy
     auto sell = TestOrderFactory::CreateSell(1, 100.0, 10);
@@ -108,16 +128,16 @@ TEST_F(OrderBookEngineTest, BuyPartialFill)
     // Book state: resting sell partially filled
     auto best_ask = engine.asks().best_price();
     ASSERT_TRUE(best_ask.has_value());
-    EXPECT_DOUBLE_EQ(best_ask.value(), 100.0);
+    EXPECT_EQ(best_ask.value(), to_ticks(100.0));
 
     // Remaining quantity of resting sell
-    EXPECT_EQ(engine.asks().get_orders_at_price(100.0).front().quantity, 5);
+    EXPECT_EQ(engine.asks().get_orders_at_price(to_ticks(100.0)).front().quantity, 5);
 
     // No buy orders remain in the book
     EXPECT_FALSE(engine.bids().best_price().has_value());
 }
 
-TEST_F(OrderBookEngineTest, BuyMatchesMultiplePriceLevels)
+TEST_P(OrderBookEngineTest, BuyMatchesMultiplePriceLevels)
 {
     auto sells = {TestOrderFactory::CreateSell(1, 100.0, 5), TestOrderFactory::CreateSell(2, 101.0, 10)};
     for (auto sell : sells)
@@ -126,11 +146,11 @@ TEST_F(OrderBookEngineTest, BuyMatchesMultiplePriceLevels)
     engine.add_order(incoming);
 
     // After: both sells reduced/removed
-    EXPECT_TRUE(engine.asks().get_orders_at_price(100.0).empty());           // fully consumed
-    EXPECT_EQ(engine.asks().get_orders_at_price(101.0).front().quantity, 3); // partial
+    EXPECT_TRUE(engine.asks().get_orders_at_price(to_ticks(100.0)).empty());           // fully consumed
+    EXPECT_EQ(engine.asks().get_orders_at_price(to_ticks(101.0)).front().quantity, 3); // partial
 }
 
-TEST_F(OrderBookEngineTest, SellMatchesBuyFIFO)
+TEST_P(OrderBookEngineTest, SellMatchesBuyFIFO)
 {
     auto buys = {TestOrderFactory::CreateBuy(1, 101.0, 10), TestOrderFactory::CreateBuy(2, 100.0, 5)};
     for (auto buy : buys)
@@ -139,7 +159,316 @@ TEST_F(OrderBookEngineTest, SellMatchesBuyFIFO)
     engine.add_order(incoming);
 
     // Buy #1 fully filled
-    EXPECT_TRUE(engine.bids().get_orders_at_price(101.0).empty());
+    EXPECT_TRUE(engine.bids().get_orders_at_price(to_ticks(101.0)).empty());
     // Buy #2 partially filled
-    EXPECT_EQ(engine.bids().get_orders_at_price(100.0).front().quantity, 3);
+    EXPECT_EQ(engine.bids().get_orders_at_price(to_ticks(100.0)).front().quantity, 3);
+}
+
+TEST_P(OrderBookEngineTest, FillsKeepLevelAggregateInStep)
+{
+    auto sells = {TestOrderFactory::CreateSell(1, 100.0, 5), TestOrderFactory::CreateSell(2, 100.0, 10)};
+    for (auto sell : sells)
+        engine.add_order(sell);
+    auto incoming = TestOrderFactory::CreateBuy(3, 100.0, 8);
+    engine.add_order(incoming);
+
+    // order 1 gone, order 2 reduced to 7
+    std::vector<PriceLevelView> levels;
+    engine.asks().for_each_level([&](const PriceLevelView &lvl)
+                                 { levels.push_back(lvl); });
+    ASSERT_EQ(levels.size(), 1);
+    EXPECT_EQ(levels[0].order_count, 1);
+    EXPECT_EQ(levels[0].aggregate_qty, 7);
+}
+
+TEST_P(OrderBookEngineTest, AddOrdersBatchMatchesLikeSingleAdds)
+{
+    std::vector<Order> batch = {
+        TestOrderFactory::CreateSell(1, 100.0, 5),
+        TestOrderFactory::CreateSell(2, 101.0, 10),
+        TestOrderFactory::CreateBuy(3, 101.0, 12),
+        TestOrderFactory::CreateBuy(4, 99.0, 4),
+    };
+    engine.add_orders(batch);
+
+    EXPECT_TRUE(engine.asks().empty_at_price(to_ticks(100.0)));
+    EXPECT_EQ(engine.asks().get_orders_at_price(to_ticks(101.0)).front().quantity, 3);
+    EXPECT_EQ(batch[2].quantity, 0); // taker fully filled in place
+    EXPECT_EQ(engine.bids().best_price().value(), to_ticks(99.0));
+
+    engine.cancel_order(4);
+    EXPECT_FALSE(engine.bids().best_price().has_value());
+}
+
+TEST(OrderBookEngineLadderTest, OutlierPriceDoesNotRest)
+{
+    OrderBookEngineConfig config;
+    config.ladder_window_ticks = 16;
+    config.ladder_max_window_ticks = 64;
+    EventBus bus;
+    PriceTimeLadderEngine engine(bus, {}, config);
+
+    auto buy = TestOrderFactory::CreateBuy(1, 100.0, 10);
+    auto outlier = TestOrderFactory::CreateBuy(2, 1'000'000.0, 10);
+    engine.add_order(buy);
+    engine.add_order(outlier); // would stretch the ladder to ~10^8 ticks
+
+    EXPECT_EQ(engine.bids().num_levels(), 1u);
+    EXPECT_EQ(engine.bids().best_price().value(), to_ticks(100.0));
+    EXPECT_LE(engine.bids().window_ticks(), 64u);
+    engine.cancel_order(2); // unknown id: a no-op
+    EXPECT_EQ(engine.bids().num_levels(), 1u);
+}
+
+TEST(OrderBookEngineIdIndexTest, DirectPerFeederIndexCancelsAndFills)
+{
+    using utils::general::encode_order_id;
+    OrderBookEngineConfig config;
+    config.id_index_mode = IdIndexMode::DirectPerFeeder;
+    config.id_feeder_window = 4; // tiny window: force spills into the table
+    EventBus bus;
+    OrderBookEngine engine(bus, std::make_unique<PriceTimePriorityStrategy>(), config);
+
+    for (uint64_t counter = 0; counter < 8; ++counter)
+    {
+        auto buy = TestOrderFactory::CreateBuy(encode_order_id(1, counter), 100.0, 10);
+        engine.add_order(buy);
+    }
+    engine.cancel_order(encode_order_id(1, 1));
+    engine.cancel_order(encode_order_id(1, 5));
+    EXPECT_EQ(engine.bids().get_orders_at_price(to_ticks(100.0)).size(), 6u);
+
+    // fills walk the queue front to back through the index
+    auto sell = TestOrderFactory::CreateSell(encode_order_id(2, 0), 100.0, 60);
+    engine.add_order(sell);
+    EXPECT_TRUE(engine.bids().empty_at_price(to_ticks(100.0)));
+}
+
+// --- Statically dispatched engines behave like the runtime-selected one ---
+
+template <typename Engine>
+class StaticOrderBookEngineTest : public ::testing::Test
+{
+protected:
+    static OrderBookEngineConfig make_config()
+    {
+        OrderBookEngineConfig config;
+        config.ladder_window_ticks = 16;
+        return config;
+    }
+
+    EventBus bus;
+    Engine engine{bus, PriceTimePriorityStrategy{}, make_config()};
+};
+
+using StaticEngines = ::testing::Types<PriceTimeMapEngine, PriceTimeLadderEngine>;
+TYPED_TEST_SUITE(StaticOrderBookEngineTest, StaticEngines);
+
+TYPED_TEST(StaticOrderBookEngineTest, MatchesAndCancels)
+{
+    auto sells = {TestOrderFactory::CreateSell(1, 100.0, 5), TestOrderFactory::CreateSell(2, 101.0, 10)};
+    for (auto sell : sells)
+        this->engine.add_order(sell);
+    auto incoming = TestOrderFactory::CreateBuy(3, 101.0, 12);
+    this->engine.add_order(incoming);
+
+    EXPECT_TRUE(this->engine.asks().empty_at_price(to_ticks(100.0)));
+    EXPECT_EQ(this->engine.asks().get_orders_at_price(to_ticks(101.0)).front().quantity, 3);
+
+    this->engine.cancel_order(2);
+    EXPECT_FALSE(this->engine.asks().best_price().has_value());
+}
+
+// Fused execution (static engine) and FillOp planning (runtime engine) must
+// produce the same trades and the same resting book
+TEST(OrderBookEngineFusedTest, FusedAndPlannedModesAgree)
+{
+    EventBus fused_bus, planned_bus;
+    PriceTimeMapEngine fused(fused_bus);
+    OrderBookEngine planned(planned_bus);
+
+    std::mutex mtx;
+    std::vector<E_Fill> fused_fills, planned_fills;
+    fused_bus.add_listener([&](const Event &e)
+                           { if (e.type == EventType::Fill) { std::lock_guard lock(mtx); fused_fills.push_back(e.d.fill); } });
+    planned_bus.add_listener([&](const Event &e)
+                             { if (e.type == EventType::Fill) { std::lock_guard lock(mtx); planned_fills.push_back(e.d.fill); } });
+
+    std::vector<Order> flow = {
+        TestOrderFactory::CreateSell(1, 100.0, 5),
+        TestOrderFactory::CreateSell(2, 100.0, 7),
+        TestOrderFactory::CreateSell(3, 100.5, 4),
+        TestOrderFactory::CreateBuy(4, 100.5, 10), // sweeps 1, part of 2
+        TestOrderFactory::CreateBuy(5, 99.0, 8),
+        TestOrderFactory::CreateSell(6, 98.0, 20), // takes 5, rests 12
+        TestOrderFactory::CreateBuy(7, 101.0, 3),
+    };
+    for (const Order &o : flow)
+    {
+        Order a = o, b = o;
+        fused.add_order(a);
+        planned.add_order(b);
+        EXPECT_EQ(a.quantity, b.quantity) << "order " << o.id;
+    }
+
+    // listeners run on their own threads: wait for the 4 expected fills
+    constexpr size_t expected_fills = 4;
+    for (int i = 0; i < 1000; ++i)
+    {
+        {
+            std::lock_guard lock(mtx);
+            if (fused_fills.size() >= expected_fills && planned_fills.size() >= expected_fills)
+                break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::lock_guard lock(mtx);
+    ASSERT_EQ(fused_fills.size(), expected_fills);
+    ASSERT_EQ(planned_fills.size(), expected_fills);
+    for (size_t i = 0; i < fused_fills.size(); ++i)
+    {
+        EXPECT_EQ(fused_fills[i].makerId, planned_fills[i].makerId);
+        EXPECT_EQ(fused_fills[i].takerId, planned_fills[i].takerId);
+        EXPECT_EQ(fused_fills[i].px, planned_fills[i].px);
+        EXPECT_EQ(fused_fills[i].qty, planned_fills[i].qty);
+    }
+
+    auto levels = [](const IOrderBookSide &side)
+    {
+        std::vector<std::pair<Price, uint64_t>> out;
+        side.for_each_level([&](const PriceLevelView &l)
+                            { out.emplace_back(l.price, l.aggregate_qty); });
+        return out;
+    };
+    EXPECT_EQ(levels(fused.bids()), levels(planned.bids()));
+    EXPECT_EQ(levels(fused.asks()), levels(planned.asks()));
+}
+
+// A sweep publishes one final LevelAgg per touched level, in both matching modes
+template <typename Engine>
+static std::vector<E_LevelAgg> sweep_levels()
+{
+    EventBus bus;
+    Engine engine(bus);
+    std::mutex mtx;
+    std::vector<E_LevelAgg> levels;
+    std::atomic<bool> done{false};
+    bus.add_listener([&](const Event &e)
+                     {
+        if (e.type == EventType::LevelAgg) { std::lock_guard lock(mtx); levels.push_back(e.d.level); }
+        if (e.type == EventType::OrderRemoved && e.d.removed.id == 99) done = true; });
+
+    std::vector<Order> resting = {
+        TestOrderFactory::CreateSell(1, 100.0, 5),
+        TestOrderFactory::CreateSell(2, 100.0, 5),
+        TestOrderFactory::CreateSell(3, 100.0, 5),
+        TestOrderFactory::CreateSell(4, 100.5, 10),
+    };
+    engine.add_orders(resting);
+    auto sweep = TestOrderFactory::CreateBuy(5, 100.5, 17); // takes 1-3, 2 of 4
+    engine.add_order(sweep);
+    auto marker = TestOrderFactory::CreateBuy(99, 90.0, 1);
+    engine.add_order(marker);
+    engine.cancel_order(99);
+
+    for (int i = 0; i < 1000 && !done; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    bus.stop_all();
+    return levels;
+}
+
+TEST(OrderBookEngineLevelAggTest, SweepPublishesOneLevelAggPerTouchedLevel)
+{
+    for (const auto &levels : {sweep_levels<PriceTimeMapEngine>(), sweep_levels<OrderBookEngine>()})
+    {
+        // the resting batch's two levels, the sweep's two, then the marker added and cancelled
+        ASSERT_EQ(levels.size(), 6u);
+        EXPECT_EQ(levels[0].aggQty, 15);
+        EXPECT_EQ(levels[1].aggQty, 10);
+        EXPECT_EQ(levels[2].px, to_ticks(100.0));
+        EXPECT_EQ(levels[2].aggQty, 0);
+        EXPECT_EQ(levels[3].px, to_ticks(100.5));
+        EXPECT_EQ(levels[3].aggQty, 8);
+        EXPECT_EQ(levels[4].aggQty, 1);
+        EXPECT_EQ(levels[5].px, to_ticks(90.0));
+        EXPECT_EQ(levels[5].aggQty, 0); // cancels publish the level too
+    }
+}
+
+TEST(OrderBookEngineLevelAggTest, ResyncRequestRepublishesEveryLevel)
+{
+    EventBus bus;
+    PriceTimeMapEngine engine(bus);
+    std::mutex mtx;
+    std::vector<E_LevelAgg> levels;
+    std::vector<Seq> seqs;
+    bus.add_listener([&](const Event &e)
+                     {
+        std::lock_guard lock(mtx);
+        seqs.push_back(e.seq);
+        if (e.type == EventType::LevelAgg) levels.push_back(e.d.level); });
+
+    std::vector<Order> resting = {
+        TestOrderFactory::CreateBuy(1, 99.0, 5),
+        TestOrderFactory::CreateBuy(2, 98.0, 5),
+        TestOrderFactory::CreateSell(3, 101.0, 5),
+    };
+    engine.add_orders(resting);
+
+    bus.request_resync();
+    auto next = TestOrderFactory::CreateSell(4, 102.0, 1);
+    engine.add_order(next); // carries the snapshot
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        {
+            std::lock_guard lock(mtx);
+            if (levels.size() >= 7)
+                break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    bus.stop_all();
+
+    // 3 levels from the batch, then all 4 levels once
+    ASSERT_EQ(levels.size(), 7u);
+    std::vector<Price> snapshot;
+    for (size_t i = 3; i < levels.size(); ++i)
+        snapshot.push_back(levels[i].px);
+    std::ranges::sort(snapshot);
+    EXPECT_EQ(snapshot, (std::vector<Price>{to_ticks(98.0), to_ticks(99.0), to_ticks(101.0), to_ticks(102.0)}));
+
+    // one global sequence across operations
+    for (size_t i = 0; i < seqs.size(); ++i)
+        EXPECT_EQ(seqs[i], i + 1);
+}
+
+TEST(OrderBookEngineTimestampTest, EventsCarryTheConfiguredClock)
+{
+    ManualClock clock(1'000'000'000);
+    OrderBookEngineConfig config;
+    config.clock = &clock;
+    EventBus bus;
+    PriceTimeMapEngine engine(bus, {}, config);
+    std::mutex mtx;
+    std::vector<Timestamp> stamps;
+    bus.add_listener([&](const Event &e)
+                     { std::lock_guard lock(mtx); stamps.push_back(e.ts); });
+
+    auto buy = TestOrderFactory::CreateBuy(1, 100.0, 10);
+    engine.add_order(buy); // OrderAdded + LevelAgg
+    clock.advance(250);
+    engine.cancel_order(1); // OrderRemoved + LevelAgg
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        {
+            std::lock_guard lock(mtx);
+            if (stamps.size() >= 4)
+                break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    bus.stop_all();
+    EXPECT_EQ(stamps, (std::vector<Timestamp>{1'000'000'000, 1'000'000'000, 1'000'000'250, 1'000'000'250}));
 }
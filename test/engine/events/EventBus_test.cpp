@@ -0,0 +1,388 @@
+#include <gtest/gtest.h>
+
+#include "engine/events/EventBus.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+// Poll until pred holds or ~2s pass
+template <typename Pred>
+static bool eventually(Pred pred)
+{
+    for (int i = 0; i < 400 && !pred(); ++i)
+        std::this_thread::sleep_for(5ms);
+    return pred();
+}
+
+static Event fill_event(uint32_t seq)
+{
+    return Event::make(0, seq, E_Fill{1, 2, 100, 1});
+}
+
+TEST(EventBusTest, ParkingListenerSleepsWhenIdleAndWakesOnPublish)
+{
+    EventBus bus(64);
+    std::atomic<int> seen{0};
+    size_t h = bus.add_listener([&](const Event &)
+                                { ++seen; },
+                                {.dispatch = Dispatch::Dedicated, .wait = WaitStrategy::SpinPark});
+
+    // Idle bus: the listener escalates to a park instead of spinning
+    ASSERT_TRUE(eventually([&]
+                           { return bus.parked_threads() == 1; }));
+
+    bus.publish(fill_event(1));
+    ASSERT_TRUE(eventually([&]
+                           { return seen.load() == 1; }));
+
+    auto stats = bus.listener_stats(h);
+    EXPECT_EQ(stats.delivered, 1u);
+    EXPECT_EQ(stats.wakeups, 1u);
+    EXPECT_EQ(stats.spurious_wakeups, 0u);
+    EXPECT_EQ(stats.dropped, 0u);
+    bus.remove_listener(h); // must not hang on a parked listener
+}
+
+TEST(EventBusTest, BusySpinListenerNeverParks)
+{
+    EventBus bus(64);
+    std::atomic<int> seen{0};
+    size_t h = bus.add_listener([&](const Event &)
+                                { ++seen; },
+                                {.dispatch = Dispatch::Dedicated, .wait = WaitStrategy::BusySpin});
+
+    std::this_thread::sleep_for(20ms);
+    bus.publish(fill_event(1));
+    ASSERT_TRUE(eventually([&]
+                           { return seen.load() == 1; }));
+    EXPECT_EQ(bus.listener_stats(h).wakeups, 0u);
+}
+
+TEST(EventBusTest, StopAllWakesParkedListeners)
+{
+    EventBus bus(64);
+    size_t a = bus.add_listener([](const Event &) {});
+    bus.add_listener([](const Event &) {}, {.bp = Backpressure::Drop, .dispatch = Dispatch::Dedicated});
+    std::this_thread::sleep_for(50ms); // both parked on the idle bus
+    bus.stop_all();
+    EXPECT_EQ(bus.listener_stats(a).delivered, 0u); // removed: empty snapshot
+}
+
+TEST(EventBusTest, PooledListenersShareWorkersAndStayInOrder)
+{
+    constexpr int LISTENERS = 8;
+    constexpr uint32_t EVENTS = 2000;
+    EventBus bus(256, 2);
+
+    std::vector<std::vector<uint32_t>> seen(LISTENERS);
+    std::vector<size_t> handles;
+    for (int i = 0; i < LISTENERS; ++i)
+        handles.push_back(bus.add_listener([&seen, i](const Event &e)
+                                           { seen[i].push_back(e.seq); }));
+    EXPECT_EQ(bus.thread_count(), 2u); // not one thread per listener
+
+    for (uint32_t s = 0; s < EVENTS; ++s)
+        bus.publish(fill_event(s));
+
+    for (size_t h : handles)
+        ASSERT_TRUE(eventually([&]
+                               { return bus.listener_stats(h).delivered == EVENTS; }));
+    bus.stop_all();
+
+    for (const auto &v : seen)
+    {
+        ASSERT_EQ(v.size(), EVENTS);
+        for (uint32_t s = 0; s < EVENTS; ++s)
+            EXPECT_EQ(v[s], s);
+    }
+}
+
+TEST(EventBusTest, RemovedPooledListenerIsNotCalledAgain)
+{
+    EventBus bus(64, 1);
+    std::atomic<int> removed_calls{0};
+    std::atomic<int> kept_calls{0};
+    size_t removed = bus.add_listener([&](const Event &)
+                                      { ++removed_calls; });
+    bus.add_listener([&](const Event &)
+                     { ++kept_calls; });
+
+    bus.publish(fill_event(1));
+    ASSERT_TRUE(eventually([&]
+                           { return removed_calls.load() == 1 && kept_calls.load() == 1; }));
+
+    bus.remove_listener(removed);
+    bus.publish(fill_event(2));
+    ASSERT_TRUE(eventually([&]
+                           { return kept_calls.load() == 2; }));
+    EXPECT_EQ(removed_calls.load(), 1);
+}
+
+TEST(EventBusTest, ZeroPoolThreadsGivesDedicatedThreads)
+{
+    EventBus bus(64, 0);
+    bus.add_listener([](const Event &) {});
+    bus.add_listener([](const Event &) {});
+    EXPECT_EQ(bus.thread_count(), 2u);
+}
+
+TEST(EventBusTest, MaskedListenerOnlySeesWantedTypesAndStaysParked)
+{
+    EventBus bus(64, 0);
+    std::atomic<int> levels{0};
+    std::atomic<int> others{0};
+    size_t h = bus.add_listener([&](const Event &e)
+                                { (e.type == EventType::LevelAgg ? levels : others)++; },
+                                {.mask = event_bit(EventType::LevelAgg)});
+
+    ASSERT_TRUE(eventually([&]
+                           { return bus.parked_threads() == 1; }));
+    for (uint32_t s = 0; s < 10; ++s)
+        bus.publish(fill_event(s));
+    EXPECT_EQ(bus.parked_threads(), 1u); // fills never woke it
+    EXPECT_EQ(bus.listener_stats(h).wakeups, 0u);
+
+    bus.publish(Event::make(0, 10, E_LevelAgg{Order::Side::Buy, 100, 5}));
+    ASSERT_TRUE(eventually([&]
+                           { return levels.load() == 1; }));
+    EXPECT_EQ(others.load(), 0);
+    EXPECT_EQ(bus.listener_stats(h).delivered, 1u);
+    EXPECT_EQ(bus.listener_stats(h).wakeups, 1u);
+}
+
+// A lossless listener parked on a narrow mask must still step over the
+// unwanted events that fill the ring, or the publisher waits forever
+TEST(EventBusTest, GatingMaskedListenerDoesNotStallPublisherOnUnwantedTypes)
+{
+    for (Dispatch dispatch : {Dispatch::Dedicated, Dispatch::Pooled})
+    {
+        EventBus bus(64, 1);
+        std::atomic<int> levels{0};
+        size_t h = bus.add_listener([&](const Event &)
+                                    { ++levels; },
+                                    {.mask = event_bit(EventType::LevelAgg), .bp = Backpressure::SpinYield, .dispatch = dispatch});
+        ASSERT_TRUE(eventually([&]
+                               { return bus.parked_threads() == 1; }));
+
+        for (uint32_t s = 1; s <= 200; ++s) // over 3x the ring: returns only if the listener keeps up
+            bus.publish(fill_event(s));
+        bus.publish(Event::make(0, 201, E_LevelAgg{Order::Side::Buy, 100, 5}));
+
+        ASSERT_TRUE(eventually([&]
+                               { return levels.load() == 1; }));
+        EXPECT_EQ(bus.listener_stats(h).dropped, 0u);
+    }
+}
+
+namespace
+{
+    struct CountingListener final
+    {
+        static constexpr EventMask EVENT_MASK = event_bit(EventType::Fill);
+        std::atomic<int> calls{0};
+        void on_event(const Event &) { ++calls; }
+    };
+}
+
+TEST(EventBusTest, TypedListenerUsesItsMaskAndSharedOwnership)
+{
+    EventBus bus(64, 1);
+    auto listener = std::make_shared<CountingListener>();
+    std::weak_ptr<CountingListener> alive = listener;
+    size_t h = bus.add_listener(listener);
+    listener.reset(); // the bus keeps it alive
+
+    bus.publish(fill_event(1));
+    bus.publish(Event::make(0, 2, E_OrderRemoved{7})); // filtered by EVENT_MASK
+    bus.publish(fill_event(3));
+    ASSERT_TRUE(eventually([&]
+                           { return bus.listener_stats(h).delivered == 2; }));
+    EXPECT_EQ(alive.lock()->calls.load(), 2);
+
+    bus.remove_listener(h);
+    EXPECT_TRUE(alive.expired());
+}
+
+TEST(EventBusTest, TypedListenerByReference)
+{
+    EventBus bus(64, 1);
+    CountingListener listener;
+    size_t h = bus.add_listener(listener, {.mask = ALL_EVENTS});
+
+    bus.publish(Event::make(0, 1, E_OrderRemoved{7}));
+    ASSERT_TRUE(eventually([&]
+                           { return listener.calls.load() == 1; }));
+    bus.remove_listener(h);
+}
+
+namespace
+{
+    struct BatchListener final
+    {
+        static constexpr EventMask EVENT_MASK = event_bit(EventType::Fill);
+        std::atomic<int> batches{0};
+        std::vector<uint32_t> seqs; // read after the bus stops
+        void on_events(std::span<const Event> events)
+        {
+            ++batches;
+            for (const Event &e : events)
+                if (e.type == EventType::Fill)
+                    seqs.push_back(e.seq);
+        }
+    };
+}
+
+TEST(EventBusTest, BatchListenerReceivesSpansInOrder)
+{
+    EventBus bus(64, 1);
+    auto listener = std::make_shared<BatchListener>();
+    size_t h = bus.add_listener(listener);
+
+    std::vector<Event> batch;
+    for (uint32_t s = 0; s < 40; ++s)
+        batch.push_back(s % 4 == 3 ? Event::make(0, s, E_OrderRemoved{s}) : fill_event(s));
+    bus.publish(batch);
+
+    ASSERT_TRUE(eventually([&]
+                           { return bus.listener_stats(h).delivered == 30; }));
+    bus.stop_all();
+
+    EXPECT_LE(listener->batches.load(), 40); // spans, not one call per event
+    ASSERT_EQ(listener->seqs.size(), 30u);
+    for (size_t i = 1; i < listener->seqs.size(); ++i)
+        EXPECT_LT(listener->seqs[i - 1], listener->seqs[i]);
+}
+
+TEST(EventBusTest, ConflatingListenerConvergesWithoutBlockingThePublisher)
+{
+    EventBus bus(16, 0); // ring far smaller than the burst
+    std::atomic<bool> entered{false};
+    std::atomic<bool> go{false};
+    std::map<std::pair<int, int64_t>, int64_t> book; // (side, px) -> qty; read after the bus stops
+    std::atomic<int> fills{0};
+    size_t h = bus.add_listener([&](const Event &e)
+                                {
+        entered = true;
+        while (!go)
+            std::this_thread::yield(); // a stalled consumer
+        if (e.type == EventType::Fill)
+            ++fills;
+        else
+            book[{static_cast<int>(e.d.level.side), e.d.level.px}] = e.d.level.aggQty; },
+                                {.bp = Backpressure::Conflate});
+
+    bus.publish(Event::make(0, 0, E_LevelAgg{Order::Side::Buy, 100, 1}));
+    ASSERT_TRUE(eventually([&]
+                           { return entered.load(); }));
+
+    uint32_t seq = 1;
+    for (int64_t q = 1; q <= 500; ++q) // never blocks although the listener is stuck
+        for (Price px = 100; px < 104; ++px)
+            bus.publish(Event::make(0, seq++, E_LevelAgg{px % 2 ? Order::Side::Sell : Order::Side::Buy, px, q}));
+    bus.publish(fill_event(seq++));
+    go = true;
+
+    // the first level, then the fill from the ring and one update per level
+    ASSERT_TRUE(eventually([&]
+                           { return bus.listener_stats(h).delivered == 6; }));
+    const ListenerStats stats = bus.listener_stats(h);
+    bus.stop_all();
+
+    EXPECT_EQ(fills.load(), 1);
+    ASSERT_EQ(book.size(), 4u);
+    for (const auto &[key, qty] : book)
+        EXPECT_EQ(qty, 500);
+    EXPECT_EQ(stats.conflated, 2001u - 5u);
+}
+
+TEST(EventBusTest, ConflatingListenerReusesSlotsOfEmptiedLevels)
+{
+    EventBus bus(16, 0);
+    std::atomic<Price> emptied{0}; // last price whose zero level was delivered
+    size_t h = bus.add_listener([&](const Event &e)
+                                {
+        if (e.type == EventType::LevelAgg && e.d.level.aggQty == 0)
+            emptied = e.d.level.px; },
+                                {.bp = Backpressure::Conflate, .conflate_levels = 2});
+
+    // Far more distinct prices over time than the table holds, but never more
+    // than one live at once
+    uint32_t seq = 1;
+    for (Price px = 100; px < 164; ++px)
+    {
+        bus.publish(Event::make(0, seq++, E_LevelAgg{Order::Side::Buy, px, 5}));
+        bus.publish(Event::make(0, seq++, E_LevelAgg{Order::Side::Buy, px, 0}));
+        ASSERT_TRUE(eventually([&]
+                               { return emptied.load() == px; }));
+    }
+    EXPECT_EQ(bus.listener_stats(h).dropped, 0u);
+    bus.stop_all();
+}
+
+namespace
+{
+    struct GapListener final
+    {
+        std::atomic<bool> entered{false};
+        std::atomic<bool> go{false};
+        std::atomic<int> gap_calls{0};
+        Seq expected = 0, got = 0; // read after the bus stops
+        void on_event(const Event &)
+        {
+            entered = true;
+            while (!go)
+                std::this_thread::yield();
+        }
+        bool on_gap(Seq e, Seq g)
+        {
+            expected = e;
+            got = g;
+            ++gap_calls;
+            return true;
+        }
+    };
+}
+
+TEST(EventBusTest, LappedDropListenerDetectsGapAndRequestsResync)
+{
+    EventBus bus(16, 0);
+    auto listener = std::make_shared<GapListener>();
+    size_t h = bus.add_listener(listener, {.mask = ALL_EVENTS, .bp = Backpressure::Drop});
+
+    bus.publish(fill_event(1));
+    ASSERT_TRUE(eventually([&]
+                           { return listener->entered.load(); }));
+    for (uint32_t s = 2; s <= 100; ++s) // laps the stalled listener
+        bus.publish(fill_event(s));
+    EXPECT_FALSE(bus.take_resync_request());
+    listener->go = true;
+
+    ASSERT_TRUE(eventually([&]
+                           { return listener->gap_calls.load() == 1 && bus.listener_stats(h).delivered > 1; }));
+    const ListenerStats stats = bus.listener_stats(h);
+    bus.stop_all();
+
+    EXPECT_EQ(stats.gaps, 1u);
+    EXPECT_EQ(listener->expected, 2u);
+    EXPECT_GT(listener->got, 2u);
+    EXPECT_EQ(stats.missed, listener->got - listener->expected);
+    EXPECT_TRUE(bus.take_resync_request());
+    EXPECT_FALSE(bus.take_resync_request()); // cleared once taken
+}
+
+TEST(EventBusTest, ContiguousSequenceReportsNoGaps)
+{
+    EventBus bus(64, 1);
+    auto listener = std::make_shared<BatchListener>();
+    size_t h = bus.add_listener(listener);
+    for (uint32_t s = 1; s <= 50; ++s)
+        bus.publish(fill_event(s));
+    ASSERT_TRUE(eventually([&]
+                           { return bus.listener_stats(h).delivered == 50; }));
+    EXPECT_EQ(bus.listener_stats(h).gaps, 0u);
+}
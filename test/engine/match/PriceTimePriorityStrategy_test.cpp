@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "engine/side/OrderBookSide.h"
+#include "engine/side/LadderBookSide.h"
 #include "engine/match/PriceTimePriorityStrategy.h"
 #include "test_utils/OrderFactory.h"
 
@@ -26,7 +27,7 @@ TEST(PriceTimePriorityStrategyTest, PartialFill)
     ASSERT_EQ(fills.size(), 1);
     EXPECT_EQ(fills[0].quantity, 5); // partially fills
     EXPECT_EQ(incoming.quantity, 5); // remaining qty
-    EXPECT_EQ(fills[0].price, 100);
+    EXPECT_EQ(fills[0].price, to_ticks(100.0));
     EXPECT_EQ(result.filledQty, 5);
 }
 
@@ -66,7 +67,7 @@ TEST(PriceTimePriorityStrategyTest, ExactMatch)
     ASSERT_EQ(fills.size(), 1);
     EXPECT_EQ(fills[0].quantity, 10);
     EXPECT_EQ(incoming.quantity, 0);
-    EXPECT_EQ(fills[0].price, 100);
+    EXPECT_EQ(fills[0].price, to_ticks(100.0));
     EXPECT_EQ(result.filledQty, 10);
 }
 
@@ -92,8 +93,8 @@ TEST(PriceTimePriorityStrategyTest, FillsMultiplePriceLevels)
     EXPECT_EQ(fills[0].quantity, 5); // filled at 100
     EXPECT_EQ(fills[1].quantity, 7); // partially filled at 101
     EXPECT_EQ(incoming.quantity, 0);
-    EXPECT_EQ(fills[0].price, 100);
-    EXPECT_EQ(fills[1].price, 101);
+    EXPECT_EQ(fills[0].price, to_ticks(100.0));
+    EXPECT_EQ(fills[1].price, to_ticks(101.0));
     EXPECT_EQ(result.filledQty, 12);
 }
 
@@ -114,6 +115,77 @@ TEST(PriceTimePriorityStrategyTest, IncomingSmallerThanTopOfBook)
     ASSERT_EQ(fills.size(), 1);
     EXPECT_EQ(fills[0].quantity, 3);
     EXPECT_EQ(incoming.quantity, 0);
-    EXPECT_EQ(fills[0].price, 100);
+    EXPECT_EQ(fills[0].price, to_ticks(100.0));
     EXPECT_EQ(result.filledQty, 3);
 }
+
+// Static dispatch on a concrete side gives the same fills as the virtual path
+TEST(PriceTimePriorityStrategyTest, MatchSideOnLadderSweepsLevels)
+{
+    AskLadderSide sell_side(16);
+    sell_side.add_order(TestOrderFactory::CreateSell(1, 100.0, 5));
+    sell_side.add_order(TestOrderFactory::CreateSell(2, 100.0, 5));
+    sell_side.add_order(TestOrderFactory::CreateSell(3, 100.05, 5));
+    sell_side.add_order(TestOrderFactory::CreateSell(4, 100.10, 5));
+
+    Order incoming = TestOrderFactory::CreateBuy(99, 100.05, 12);
+
+    PriceTimePriorityStrategy strat;
+    std::vector<FillOp> fills;
+    MatchResult result = strat.match_side(incoming, sell_side, fills);
+
+    ASSERT_EQ(fills.size(), 3);
+    EXPECT_EQ(fills[0].makerOrderId, 1);
+    EXPECT_EQ(fills[1].makerOrderId, 2);
+    EXPECT_EQ(fills[2].makerOrderId, 3);
+    EXPECT_EQ(fills[2].quantity, 2);
+    EXPECT_EQ(fills[2].price, to_ticks(100.05));
+    EXPECT_EQ(result.filledQty, 12);
+}
+
+// Views other than the built-in backends go through the virtual interface
+class SingleLevelView : public IOrderBookSideView
+{
+public:
+    explicit SingleLevelView(std::vector<Order> orders) : orders_(std::move(orders)) {}
+
+    std::optional<Price> best_price() const override { return orders_.front().price; }
+    std::optional<Price> next_price(Price) const override { return std::nullopt; }
+    size_t num_levels() const override { return 1; }
+    void for_each_level(const std::function<void(const PriceLevelView &)> &) const override {}
+    void for_each_order_at_price(Price, const std::function<void(const Order &)> &fn) const override
+    {
+        for (const auto &o : orders_)
+            fn(o);
+    }
+
+private:
+    std::vector<Order> orders_;
+};
+
+TEST(PriceTimePriorityStrategyTest, MatchesThroughVirtualViewFallback)
+{
+    SingleLevelView view({TestOrderFactory::CreateSell(1, 100.0, 4), TestOrderFactory::CreateSell(2, 100.0, 4)});
+    Order incoming = TestOrderFactory::CreateBuy(99, 100.0, 6);
+
+    PriceTimePriorityStrategy strat;
+    std::vector<FillOp> fills;
+    MatchResult result = strat.match(incoming, view, fills);
+
+    ASSERT_EQ(fills.size(), 2);
+    EXPECT_EQ(fills[1].makerOrderId, 2);
+    EXPECT_EQ(fills[1].quantity, 2);
+    EXPECT_EQ(result.filledQty, 6);
+}
+
+// match() dispatches on the tag: each backend must report its own
+TEST(PriceTimePriorityStrategyTest, SidesReportTheirBackend)
+{
+    EXPECT_EQ(BidBookSide().backend(), SideBackend::BidMap);
+    EXPECT_EQ(AskBookSide().backend(), SideBackend::AskMap);
+    EXPECT_EQ(BidLadderSide().backend(), SideBackend::BidLadder);
+    EXPECT_EQ(AskLadderSide().backend(), SideBackend::AskLadder);
+
+    SingleLevelView view({});
+    EXPECT_EQ(view.backend(), SideBackend::Other);
+}
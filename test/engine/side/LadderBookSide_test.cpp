@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include "engine/side/LadderBookSide.h"
+#include "test_utils/OrderFactory.h"
+
+TEST(LadderBookSideTest, EmptyLadderBookSide)
+{
+    BidLadderSide side;
+    EXPECT_FALSE(side.best_price().has_value());
+    EXPECT_EQ(side.num_levels(), 0);
+}
+
+TEST(LadderBookSideTest, BestPriceBuySide)
+{
+    BidLadderSide side;
+    side.add_order(TestOrderFactory::CreateBuy(1, 100.0, 10));
+    side.add_order(TestOrderFactory::CreateBuy(2, 101.0, 5));
+    side.add_order(TestOrderFactory::CreateBuy(3, 99.0, 20));
+
+    ASSERT_TRUE(side.best_price().has_value());
+    EXPECT_EQ(side.best_price().value(), to_ticks(101.0));
+    EXPECT_EQ(side.num_levels(), 3);
+    EXPECT_EQ(side.get_orders_at_price(to_ticks(101.0)).front().id, 2);
+}
+
+TEST(LadderBookSideTest, BestPriceSellSide)
+{
+    AskLadderSide side;
+    side.add_order(TestOrderFactory::CreateSell(1, 100.0, 10));
+    side.add_order(TestOrderFactory::CreateSell(2, 101.0, 5));
+    side.add_order(TestOrderFactory::CreateSell(3, 99.0, 20));
+
+    ASSERT_TRUE(side.best_price().has_value());
+    EXPECT_EQ(side.best_price().value(), to_ticks(99.0));
+}
+
+TEST(LadderBookSideTest, RemovingBestLevelFindsNextBest)
+{
+    AskLadderSide side;
+    side.add_order(TestOrderFactory::CreateSell(1, 100.00, 10));
+    side.add_order(TestOrderFactory::CreateSell(2, 100.05, 10));
+    side.add_order(TestOrderFactory::CreateSell(3, 100.10, 10));
+
+    side.remove_price_level(to_ticks(100.00));
+    ASSERT_TRUE(side.best_price().has_value());
+    EXPECT_EQ(side.best_price().value(), to_ticks(100.05));
+
+    side.remove_price_level(to_ticks(100.05));
+    side.remove_price_level(to_ticks(100.10));
+    EXPECT_FALSE(side.best_price().has_value());
+    EXPECT_EQ(side.num_levels(), 0);
+}
+
+TEST(LadderBookSideTest, LevelsIterateBestToWorst)
+{
+    BidLadderSide side;
+    side.add_order(TestOrderFactory::CreateBuy(1, 100.00, 10));
+    side.add_order(TestOrderFactory::CreateBuy(2, 100.02, 5));
+    side.add_order(TestOrderFactory::CreateBuy(3, 100.02, 7));
+    side.add_order(TestOrderFactory::CreateBuy(4, 99.97, 1));
+
+    std::vector<PriceLevelView> levels;
+    side.for_each_level([&](const PriceLevelView &lvl)
+                        { levels.push_back(lvl); });
+
+    ASSERT_EQ(levels.size(), 3);
+    EXPECT_EQ(levels[0].price, to_ticks(100.02));
+    EXPECT_EQ(levels[0].order_count, 2);
+    EXPECT_EQ(levels[0].aggregate_qty, 12);
+    EXPECT_EQ(levels[1].price, to_ticks(100.00));
+    EXPECT_EQ(levels[2].price, to_ticks(99.97));
+}
+
+TEST(LadderBookSideTest, DriftOutsideWindowRecenters)
+{
+    AskLadderSide side(32);
+    auto it = side.add_order_and_get_iterator(TestOrderFactory::CreateSell(1, 100.00, 10));
+    side.add_order(TestOrderFactory::CreateSell(2, 100.20, 10)); // 20 ticks away, same window
+
+    // Market drifts: 100.00 leaves, new prices arrive 40 ticks higher
+    side.add_order(TestOrderFactory::CreateSell(3, 100.40, 10));
+
+    EXPECT_EQ(side.window_ticks(), 64); // live band 41 ticks no longer fits 32
+    EXPECT_EQ(side.best_price().value(), to_ticks(100.00));
+    EXPECT_EQ(it->id, 1); // iterators survive the move
+    EXPECT_EQ(side.get_orders_at_price(to_ticks(100.40)).front().id, 3);
+
+    side.remove_price_level(to_ticks(100.00));
+    side.recenter(to_ticks(100.30));
+    EXPECT_EQ(side.best_price().value(), to_ticks(100.20));
+    EXPECT_EQ(side.num_levels(), 2);
+}
+
+TEST(LadderBookSideTest, RecenterKeepsLiveLevels)
+{
+    BidLadderSide side(16);
+    side.add_order(TestOrderFactory::CreateBuy(1, 100.00, 10));
+
+    // Centre far away: the window must still cover the live level
+    side.recenter(to_ticks(200.00));
+    EXPECT_FALSE(side.empty_at_price(to_ticks(100.00)));
+    EXPECT_EQ(side.best_price().value(), to_ticks(100.00));
+}
+
+TEST(LadderBookSideTest, ConstLookupOutsideWindowIsEmpty)
+{
+    BidLadderSide side(16);
+    side.add_order(TestOrderFactory::CreateBuy(1, 100.00, 10));
+
+    const auto &cside = side;
+    EXPECT_TRUE(cside.get_orders_at_price(to_ticks(500.00)).empty());
+    EXPECT_TRUE(side.empty_at_price(to_ticks(500.00)));
+}
+
+TEST(LadderBookSideTest, LookupOutsideWindowLeavesItAlone)
+{
+    BidLadderSide side(16);
+    side.add_order(TestOrderFactory::CreateBuy(1, 100.00, 10));
+    const Price base = side.window_base();
+
+    EXPECT_TRUE(side.get_orders_at_price(to_ticks(5000.00)).empty()); // non-const lookup
+    EXPECT_EQ(side.window_base(), base);
+    EXPECT_EQ(side.window_ticks(), 16);
+}
+
+TEST(LadderBookSideTest, WindowStopsGrowingAtItsCap)
+{
+    AskLadderSide side(16, 64);
+    side.add_order(TestOrderFactory::CreateSell(1, 100.00, 10));
+
+    const Price far = to_ticks(100.00) + 64; // live band of 65 ticks
+    EXPECT_TRUE(side.accepts_price(far - 1));
+    EXPECT_FALSE(side.accepts_price(far));
+
+    side.add_order(TestOrderFactory::CreateSell(2, 100.64, 10)); // refused: not stored
+    EXPECT_EQ(side.num_levels(), 1);
+    EXPECT_EQ(side.window_ticks(), 16);
+
+    side.add_order(TestOrderFactory::CreateSell(3, 100.63, 10)); // fits, capped at 64
+    EXPECT_EQ(side.num_levels(), 2);
+    EXPECT_EQ(side.window_ticks(), 64);
+    EXPECT_EQ(side.get_orders_at_price(far - 1).front().id, 3);
+}
+
+TEST(LadderBookSideTest, NextPriceWalksLiveLevels)
+{
+    AskLadderSide side(4096);
+    side.add_order(TestOrderFactory::CreateSell(1, 100.00, 10));
+    side.add_order(TestOrderFactory::CreateSell(2, 110.00, 10)); // 1000 empty ticks apart
+    side.add_order(TestOrderFactory::CreateSell(3, 110.01, 10));
+
+    EXPECT_EQ(side.next_price(to_ticks(100.00)).value(), to_ticks(110.00));
+    EXPECT_EQ(side.next_price(to_ticks(110.00)).value(), to_ticks(110.01));
+    EXPECT_FALSE(side.next_price(to_ticks(110.01)).has_value());
+}
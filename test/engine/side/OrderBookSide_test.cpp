@@ -15,7 +15,7 @@ TEST(OrderBookSideTest, RemoveNonExistentOrderDoesNothing)
     side.add_order(TestOrderFactory::CreateSell(1, 50.0, 10));
 
     // Try to remove a non-existent order manually
-    double price = 50.0;
+    Price price = to_ticks(50.0);
     auto &orders = side.get_orders_at_price(price);
     auto it = std::find_if(orders.begin(), orders.end(), [](const Order &o)
                            { return o.id == 9999; });
@@ -24,7 +24,7 @@ TEST(OrderBookSideTest, RemoveNonExistentOrderDoesNothing)
 
     auto best_price = side.best_price();
     ASSERT_TRUE(best_price.has_value());
-    EXPECT_DOUBLE_EQ(best_price.value(), 50.0);
+    EXPECT_EQ(best_price.value(), to_ticks(50.0));
 
     EXPECT_EQ(side.get_orders_at_price(best_price.value()).size(), 1);
 }
@@ -35,9 +35,9 @@ TEST(OrderBookSideTest, RemoveLastOrderRemovesPriceLevel)
     side.add_order(TestOrderFactory::CreateBuy(1, 100.0, 10));
 
     // Remove the order
-    auto &orders = side.get_orders_at_price(100.0);
+    auto &orders = side.get_orders_at_price(to_ticks(100.0));
     orders.clear();
-    side.remove_price_level(100.0);
+    side.remove_price_level(to_ticks(100.0));
 
     EXPECT_FALSE(side.best_price().has_value());
 }
@@ -56,7 +56,7 @@ TEST(OrderBookSideTest, RemoveOrderRemovesCorrectly)
 
     auto best_price = buy_side.best_price();
     ASSERT_TRUE(best_price.has_value());
-    EXPECT_DOUBLE_EQ(best_price.value(), 100.0);
+    EXPECT_EQ(best_price.value(), to_ticks(100.0));
 
     auto &best_orders = buy_side.get_orders_at_price(*best_price);
     EXPECT_EQ(best_orders.size(), 3);
@@ -87,7 +87,7 @@ TEST(OrderBookSideTest, AddAndRetrieveBestPriceBuySide)
 
     auto best_price = buy_side.best_price();
     ASSERT_TRUE(best_price.has_value());
-    EXPECT_DOUBLE_EQ(best_price.value(), 101.0);
+    EXPECT_EQ(best_price.value(), to_ticks(101.0));
 
     auto &best_orders = buy_side.get_orders_at_price(*best_price);
     ASSERT_EQ(best_orders.size(), 1);
@@ -108,7 +108,7 @@ TEST(OrderBookSideTest, AddAndRetrieveBestPriceSellSide)
 
     auto best_price = sell_side.best_price();
     ASSERT_TRUE(best_price.has_value());
-    EXPECT_DOUBLE_EQ(best_price.value(), 99.0);
+    EXPECT_EQ(best_price.value(), to_ticks(99.0));
 
     auto &best_orders = sell_side.get_orders_at_price(*best_price);
     ASSERT_EQ(best_orders.size(), 1);
@@ -124,7 +124,7 @@ TEST(OrderBookSideTest, MultiplePriceLevelsBestPrice)
 
     auto best_price = buy_side.best_price();
     ASSERT_TRUE(best_price.has_value());
-    EXPECT_DOUBLE_EQ(best_price.value(), 105.0);
+    EXPECT_EQ(best_price.value(), to_ticks(105.0));
 
     AskBookSide sell_side;
     sell_side.add_order(TestOrderFactory::CreateSell(4, 200.0, 10));
@@ -133,7 +133,37 @@ TEST(OrderBookSideTest, MultiplePriceLevelsBestPrice)
 
     best_price = sell_side.best_price();
     ASSERT_TRUE(best_price.has_value());
-    EXPECT_DOUBLE_EQ(best_price.value(), 195.0);
+    EXPECT_EQ(best_price.value(), to_ticks(195.0));
+}
+
+TEST(OrderBookSideTest, NextPriceWalksBestToWorst)
+{
+    BidBookSide side;
+    side.add_order(TestOrderFactory::CreateBuy(1, 100.0, 10));
+    side.add_order(TestOrderFactory::CreateBuy(2, 98.0, 10));
+
+    EXPECT_EQ(side.next_price(to_ticks(100.0)).value(), to_ticks(98.0));
+    EXPECT_EQ(side.next_price(to_ticks(99.0)).value(), to_ticks(98.0));
+    EXPECT_FALSE(side.next_price(to_ticks(98.0)).has_value());
+}
+
+TEST(OrderBookSideTest, ForEachLevelReportsCountAndAggregateQty)
+{
+    AskBookSide side;
+    side.add_order(TestOrderFactory::CreateSell(1, 101.0, 10));
+    side.add_order(TestOrderFactory::CreateSell(2, 101.0, 2));
+    side.add_order(TestOrderFactory::CreateSell(3, 102.0, 7));
+
+    std::vector<PriceLevelView> levels;
+    side.for_each_level([&](const PriceLevelView &lvl)
+                        { levels.push_back(lvl); });
+
+    ASSERT_EQ(levels.size(), 2);
+    EXPECT_EQ(levels[0].price, to_ticks(101.0));
+    EXPECT_EQ(levels[0].order_count, 2);
+    EXPECT_EQ(levels[0].aggregate_qty, 12);
+    EXPECT_EQ(levels[1].order_count, 1);
+    EXPECT_EQ(levels[1].aggregate_qty, 7);
 }
 
 TEST(OrderBookSideTest, BestPriceAndOrdersEmptySide)
@@ -152,7 +182,7 @@ TEST(OrderBookSideTest, AddOrdersWithDuplicateIDs)
 
     auto best_price = side.best_price();
     ASSERT_TRUE(best_price.has_value());
-    EXPECT_DOUBLE_EQ(best_price.value(), 101.0);
+    EXPECT_EQ(best_price.value(), to_ticks(101.0));
 
     auto &best_orders = side.get_orders_at_price(*best_price);
     EXPECT_EQ(best_orders.size(), 1);
@@ -179,34 +209,47 @@ TEST(OrderBookSideTest, LargeNumberOfOrders)
 
     auto best_price = side.best_price();
     ASSERT_TRUE(best_price.has_value());
-    EXPECT_DOUBLE_EQ(best_price.value(), 100.0);
+    EXPECT_EQ(best_price.value(), to_ticks(100.0));
 
     // Remove half of the orders
     for (int i = 0; i < N / 2; ++i)
     {
-        auto &orders = side.get_orders_at_price(100.0 + i * 0.01);
+        auto &orders = side.get_orders_at_price(to_ticks(100.0 + i * 0.01));
         orders.clear();
-        side.remove_price_level(100.0 + i * 0.01);
+        side.remove_price_level(to_ticks(100.0 + i * 0.01));
     }
 
     best_price = side.best_price();
     ASSERT_TRUE(best_price.has_value());
-    EXPECT_DOUBLE_EQ(best_price.value(), 100.0 + (N / 2) * 0.01);
+    EXPECT_EQ(best_price.value(), to_ticks(100.0 + (N / 2) * 0.01));
 }
 
-TEST(OrderBookSideTest, FloatingPointPricePrecision)
+TEST(OrderBookSideTest, SubTickPricesShareOneLevel)
 {
     BidBookSide side;
 
+    // All three round onto the same tick, so they queue FIFO at one level
     side.add_order(TestOrderFactory::CreateBuy(1, 100.000001, 10));
     side.add_order(TestOrderFactory::CreateBuy(2, 100.000002, 20));
     side.add_order(TestOrderFactory::CreateBuy(3, 100.000000, 30));
 
+    EXPECT_EQ(side.num_levels(), 1);
+
     auto best_price = side.best_price();
     ASSERT_TRUE(best_price.has_value());
-    EXPECT_NEAR(best_price.value(), 100.000002, 1e-9);
+    EXPECT_EQ(best_price.value(), to_ticks(100.0));
 
     auto &best_orders = side.get_orders_at_price(*best_price);
-    EXPECT_EQ(best_orders.size(), 1);
-    EXPECT_EQ(best_orders.front().id, 2);
+    ASSERT_EQ(best_orders.size(), 3);
+    EXPECT_EQ(best_orders.front().id, 1);
+    EXPECT_EQ(best_orders.back().id, 3);
+}
+
+TEST(OrderBookSideTest, AccumulatedDecimalPriceFindsLevel)
+{
+    AskBookSide side;
+    side.add_order(TestOrderFactory::CreateSell(1, 0.3, 10));
+
+    // 0.1 + 0.2 != 0.3 as doubles, but both map to the same tick
+    EXPECT_FALSE(side.empty_at_price(to_ticks(0.1 + 0.2)));
 }
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include "engine/side/OrderIdIndex.h"
+#include "utils/GeneralUtils.h"
+
+#include <random>
+#include <unordered_map>
+
+TEST(OrderIdIndexTest, InsertFindErase)
+{
+    OrderIdIndex index(64);
+    index.insert(7, 70);
+    index.insert(8, 80);
+
+    EXPECT_EQ(index.find(7), 70u);
+    EXPECT_EQ(index.find(8), 80u);
+    EXPECT_EQ(index.find(9), NULL_ORDER_HANDLE);
+    EXPECT_EQ(index.size(), 2u);
+
+    EXPECT_TRUE(index.erase(7));
+    EXPECT_FALSE(index.erase(7));
+    EXPECT_EQ(index.find(7), NULL_ORDER_HANDLE);
+    EXPECT_EQ(index.find(8), 80u);
+    EXPECT_EQ(index.size(), 1u);
+}
+
+TEST(OrderIdIndexTest, InsertOverwritesExistingId)
+{
+    OrderIdIndex index(64);
+    index.insert(1, 10);
+    index.insert(1, 11);
+
+    EXPECT_EQ(index.find(1), 11u);
+    EXPECT_EQ(index.size(), 1u);
+}
+
+TEST(OrderIdIndexTest, GrowsPastCapacity)
+{
+    OrderIdIndex index(16);
+    for (uint64_t id = 0; id < 1000; ++id)
+        index.insert(id, static_cast<OrderHandle>(id));
+
+    EXPECT_GE(index.capacity(), 1000u);
+    for (uint64_t id = 0; id < 1000; ++id)
+        EXPECT_EQ(index.find(id), static_cast<OrderHandle>(id));
+}
+
+// Backward-shift deletion must keep every remaining id reachable
+TEST(OrderIdIndexTest, MatchesUnorderedMapUnderRandomChurn)
+{
+    OrderIdIndex index(256);
+    std::unordered_map<uint64_t, OrderHandle> reference;
+    std::mt19937_64 rng(42);
+
+    for (int step = 0; step < 20000; ++step)
+    {
+        const uint64_t id = rng() % 400;
+        if (rng() % 3)
+        {
+            const auto h = static_cast<OrderHandle>(rng() % 100000);
+            index.insert(id, h);
+            reference[id] = h;
+        }
+        else
+        {
+            EXPECT_EQ(index.erase(id), reference.erase(id) == 1);
+        }
+    }
+
+    EXPECT_EQ(index.size(), reference.size());
+    for (uint64_t id = 0; id < 400; ++id)
+    {
+        auto it = reference.find(id);
+        EXPECT_EQ(index.find(id), it == reference.end() ? NULL_ORDER_HANDLE : it->second);
+    }
+}
+
+TEST(OrderIdIndexTest, DirectModeKeepsFeedersApart)
+{
+    using utils::general::encode_order_id;
+    OrderIdIndex index(64, IdIndexMode::DirectPerFeeder, 16);
+
+    index.insert(encode_order_id(0, 3), 1);
+    index.insert(encode_order_id(1, 3), 2);
+
+    EXPECT_EQ(index.find(encode_order_id(0, 3)), 1u);
+    EXPECT_EQ(index.find(encode_order_id(1, 3)), 2u);
+    EXPECT_EQ(index.find(encode_order_id(2, 3)), NULL_ORDER_HANDLE);
+
+    EXPECT_TRUE(index.erase(encode_order_id(0, 3)));
+    EXPECT_EQ(index.find(encode_order_id(0, 3)), NULL_ORDER_HANDLE);
+    EXPECT_EQ(index.find(encode_order_id(1, 3)), 2u);
+    EXPECT_EQ(index.size(), 1u);
+}
+
+TEST(OrderIdIndexTest, DirectModeSpillsWhenWindowWraps)
+{
+    using utils::general::encode_order_id;
+    OrderIdIndex index(64, IdIndexMode::DirectPerFeeder, 16);
+
+    // counter 3 still resting when counter 19 lands on the same window slot
+    index.insert(encode_order_id(0, 3), 1);
+    index.insert(encode_order_id(0, 19), 2);
+
+    EXPECT_EQ(index.find(encode_order_id(0, 3)), 1u);
+    EXPECT_EQ(index.find(encode_order_id(0, 19)), 2u);
+    EXPECT_EQ(index.size(), 2u);
+
+    EXPECT_TRUE(index.erase(encode_order_id(0, 19)));
+    EXPECT_EQ(index.find(encode_order_id(0, 19)), NULL_ORDER_HANDLE);
+    EXPECT_EQ(index.find(encode_order_id(0, 3)), 1u);
+}
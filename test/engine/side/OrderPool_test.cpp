@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include "engine/side/OrderPool.h"
+#include "test_utils/OrderFactory.h"
+
+#include <algorithm>
+
+TEST(OrderPoolTest, PreallocatesCapacity)
+{
+    OrderPool pool(5000);
+    EXPECT_EQ(pool.capacity(), 2 * OrderPool::SLAB_SIZE); // rounded up to whole slabs
+    EXPECT_EQ(pool.in_use(), 0);
+}
+
+TEST(OrderPoolTest, FreshNodesAreAdjacent)
+{
+    OrderPool pool(OrderPool::SLAB_SIZE);
+    OrderHandle a = pool.allocate(TestOrderFactory::CreateBuy(1));
+    OrderHandle b = pool.allocate(TestOrderFactory::CreateBuy(2));
+
+    EXPECT_EQ(b, a + 1);
+    EXPECT_EQ(reinterpret_cast<const char *>(&pool[b]) - reinterpret_cast<const char *>(&pool[a]), 64);
+}
+
+TEST(OrderPoolTest, ReleasedNodesAreReused)
+{
+    OrderPool pool(OrderPool::SLAB_SIZE);
+    OrderHandle a = pool.allocate(TestOrderFactory::CreateBuy(1));
+    pool.release(a);
+    OrderHandle b = pool.allocate(TestOrderFactory::CreateBuy(2));
+
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(pool[b].id, 2);
+    EXPECT_EQ(pool.in_use(), 1);
+}
+
+TEST(OrderPoolTest, GrowsPastCapacity)
+{
+    OrderPool pool(OrderPool::SLAB_SIZE);
+    for (size_t i = 0; i <= OrderPool::SLAB_SIZE; ++i)
+        pool.allocate(TestOrderFactory::CreateBuy(i));
+
+    EXPECT_EQ(pool.capacity(), 2 * OrderPool::SLAB_SIZE);
+    EXPECT_EQ(pool.in_use(), OrderPool::SLAB_SIZE + 1);
+}
+
+TEST(OrderQueueTest, KeepsFifoOrder)
+{
+    OrderPool pool;
+    OrderQueue q(pool);
+    for (uint64_t id = 1; id <= 3; ++id)
+        q.push_back(TestOrderFactory::CreateSell(id));
+
+    ASSERT_EQ(q.size(), 3);
+    EXPECT_EQ(q.front().id, 1);
+    EXPECT_EQ(q.back().id, 3);
+
+    std::vector<uint64_t> ids;
+    for (const auto &o : q)
+        ids.push_back(o.id);
+    EXPECT_EQ(ids, (std::vector<uint64_t>{1, 2, 3}));
+}
+
+TEST(OrderQueueTest, EraseUnlinksAnyPosition)
+{
+    OrderPool pool;
+    OrderQueue q(pool);
+    auto first = q.push_back(TestOrderFactory::CreateSell(1));
+    auto middle = q.push_back(TestOrderFactory::CreateSell(2));
+    auto last = q.push_back(TestOrderFactory::CreateSell(3));
+
+    auto next = q.erase(middle);
+    EXPECT_EQ(next->id, 3);
+    q.erase(last);
+    EXPECT_EQ(q.back().id, 1);
+    q.erase(first);
+
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(pool.in_use(), 0);
+}
+
+TEST(OrderQueueTest, DestructionAndMoveReturnNodes)
+{
+    OrderPool pool;
+    {
+        OrderQueue q(pool);
+        auto it = q.push_back(TestOrderFactory::CreateSell(7));
+        q.push_back(TestOrderFactory::CreateSell(8));
+
+        OrderQueue moved(std::move(q));
+        EXPECT_TRUE(q.empty());
+        EXPECT_EQ(moved.size(), 2);
+        EXPECT_EQ(it->id, 7); // handles survive the move
+        EXPECT_EQ(pool.in_use(), 2);
+    }
+    EXPECT_EQ(pool.in_use(), 0);
+}
+
+TEST(OrderQueueTest, WorksWithStdAlgorithms)
+{
+    OrderPool pool;
+    OrderQueue q(pool);
+    q.push_back(TestOrderFactory::CreateSell(1, 100.0, 10));
+    q.push_back(TestOrderFactory::CreateSell(2, 100.0, 5));
+
+    auto it = std::find_if(q.begin(), q.end(), [](const Order &o)
+                           { return o.id == 2; });
+    ASSERT_NE(it, q.end());
+    EXPECT_EQ(it->quantity, 5);
+}
+
+TEST(OrderQueueTest, TracksCountAndAggregateQty)
+{
+    OrderPool pool;
+    OrderQueue q(pool);
+    auto a = q.push_back(TestOrderFactory::CreateSell(1, 100.0, 10));
+    q.push_back(TestOrderFactory::CreateSell(2, 100.0, 5));
+    EXPECT_EQ(q.size(), 2);
+    EXPECT_EQ(q.aggregate_qty(), 15);
+
+    EXPECT_EQ(q.reduce(a, 4), 6);
+    EXPECT_EQ(q.aggregate_qty(), 11);
+    EXPECT_EQ(q.reduce(a, 100), 0); // clamped at zero
+    EXPECT_EQ(q.aggregate_qty(), 5);
+
+    q.erase(a);
+    EXPECT_EQ(q.size(), 1);
+    EXPECT_EQ(q.aggregate_qty(), 5);
+
+    OrderQueue moved(std::move(q));
+    EXPECT_EQ(moved.aggregate_qty(), 5);
+    EXPECT_EQ(q.aggregate_qty(), 0);
+}
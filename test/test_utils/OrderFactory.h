@@ -2,6 +2,12 @@
 #include "core/Order.h"
 #include <cstdint>
 
+// Decimal test prices -> book ticks
+inline Price to_ticks(double price)
+{
+    return DEFAULT_INSTRUMENT.to_ticks(price);
+}
+
 struct TestOrderFactory
 {
     static Order CreateBuy(
@@ -12,7 +18,7 @@ struct TestOrderFactory
         uint32_t ts = 123456789,
         uint8_t controlFlags = 0)
     {
-        Order order(orderId, price, qty, Order::Side::Buy, feeder, ts);
+        Order order(orderId, to_ticks(price), qty, Order::Side::Buy, feeder, ts);
         order.controlFlags = controlFlags;
         return order;
     }
@@ -25,7 +31,7 @@ struct TestOrderFactory
         uint32_t ts = 123456789,
         uint8_t controlFlags = 0)
     {
-        Order order(orderId, price, qty, Order::Side::Sell, feeder, ts);
+        Order order(orderId, to_ticks(price), qty, Order::Side::Sell, feeder, ts);
         order.controlFlags = controlFlags;
         return order;
     }
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include "utils/concurrency/WaitStrategy.h"
+
+#include <atomic>
+#include <thread>
+
+TEST(DoorbellTest, ParkReturnsImmediatelyWhenReady)
+{
+    Doorbell bell;
+    bell.park([]
+              { return true; }); // would hang if it slept
+    SUCCEED();
+}
+
+TEST(DoorbellTest, RingWakesParkedConsumer)
+{
+    Doorbell bell;
+    std::atomic<bool> work{false};
+    std::atomic<bool> woke{false};
+
+    std::thread consumer([&]
+                         {
+        while (!work.load())
+            bell.park([&] { return work.load(); });
+        woke = true; });
+
+    while (bell.sleepers() == 0)
+        std::this_thread::yield();
+    work = true;
+    bell.ring();
+    consumer.join();
+    EXPECT_TRUE(woke.load());
+}
+
+TEST(IdleWaiterTest, SpinParkWithoutDoorbellFallsBackToYield)
+{
+    IdleWaiter waiter(WaitStrategy::SpinPark);
+    EXPECT_EQ(waiter.strategy(), WaitStrategy::SpinYield);
+}
+
+TEST(IdleWaiterTest, EscalatesToParkAndWakesOnShutdown)
+{
+    Doorbell bell;
+    std::atomic<bool> running{true};
+    std::atomic<int> polls{0};
+
+    std::thread consumer([&]
+                         {
+        IdleWaiter waiter(WaitStrategy::SpinPark, &bell, 4, 2);
+        while (running.load())
+        {
+            ++polls;
+            waiter.idle([&] { return !running.load(); });
+        } });
+
+    while (bell.sleepers() == 0) // spins, yields, then parks
+        std::this_thread::yield();
+    const int parked_at = polls.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(polls.load(), parked_at); // parked: not polling any more
+
+    running = false;
+    bell.wake_all();
+    consumer.join();
+}
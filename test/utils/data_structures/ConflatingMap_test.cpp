@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include "utils/data_structures/ConflatingMap.h"
+
+#include <map>
+#include <thread>
+#include <vector>
+
+TEST(ConflatingMapTest, DrainYieldsLatestValuePerKey)
+{
+    ConflatingMap<int, int> map(8);
+    EXPECT_TRUE(map.put(1, 10));
+    EXPECT_TRUE(map.put(2, 20));
+    EXPECT_TRUE(map.put(1, 11));
+
+    std::vector<std::pair<int, int>> seen;
+    EXPECT_EQ(map.drain([&](int k, int v)
+                        { seen.emplace_back(k, v); }),
+              2u);
+    EXPECT_EQ(seen, (std::vector<std::pair<int, int>>{{1, 11}, {2, 20}})); // first-update order
+    EXPECT_EQ(map.conflated(), 1u);
+
+    seen.clear();
+    EXPECT_EQ(map.drain([&](int k, int v)
+                        { seen.emplace_back(k, v); }),
+              0u);
+}
+
+TEST(ConflatingMapTest, DrainRespectsMaxItems)
+{
+    ConflatingMap<int, int> map(8);
+    for (int k = 0; k < 5; ++k)
+        map.put(k, k);
+
+    size_t n = 0;
+    EXPECT_EQ(map.drain([&](int, int)
+                        { ++n; }, 3),
+              3u);
+    EXPECT_EQ(map.drain([&](int, int)
+                        { ++n; }),
+              2u);
+    EXPECT_EQ(n, 5u);
+}
+
+TEST(ConflatingMapTest, NewKeyRejectedWhenFull)
+{
+    ConflatingMap<int, int> map(2);
+    EXPECT_TRUE(map.put(1, 1));
+    EXPECT_TRUE(map.put(2, 2));
+    EXPECT_FALSE(map.put(3, 3));
+    EXPECT_TRUE(map.put(2, 5)); // existing keys still update
+    EXPECT_EQ(map.size(), 2u);
+}
+
+TEST(ConflatingMapTest, RetiredKeyFreesItsSlotOnceDelivered)
+{
+    ConflatingMap<int, int> map(2);
+    EXPECT_TRUE(map.put(1, 1));
+    EXPECT_TRUE(map.put(2, 2));
+    EXPECT_TRUE(map.put(1, 0, true));
+    EXPECT_FALSE(map.put(3, 3)); // not delivered yet: still holds its slot
+
+    map.drain([](int, int) {});
+    EXPECT_TRUE(map.put(3, 3));
+    EXPECT_EQ(map.size(), 2u);
+
+    std::vector<std::pair<int, int>> seen;
+    map.drain([&](int k, int v)
+              { seen.emplace_back(k, v); });
+    EXPECT_EQ(seen, (std::vector<std::pair<int, int>>{{3, 3}}));
+}
+
+TEST(ConflatingMapTest, RetiredKeyUpdatedAgainStaysLive)
+{
+    ConflatingMap<int, int> map(2);
+    EXPECT_TRUE(map.put(1, 0, true));
+    EXPECT_TRUE(map.put(1, 5)); // back before the consumer saw the retirement
+    map.drain([](int, int) {});
+
+    EXPECT_TRUE(map.put(2, 2));
+    EXPECT_FALSE(map.put(3, 3));
+    EXPECT_EQ(map.size(), 2u);
+}
+
+TEST(ConflatingMapTest, ChurningKeysFitInASmallTable)
+{
+    constexpr int KEYS = 5000;
+    ConflatingMap<int, int> map(4);
+
+    std::thread producer([&]
+                         {
+        for (int k = 0; k < KEYS; ++k)
+        {
+            while (!map.put(k, 1))
+                std::this_thread::yield(); // full until the consumer frees a slot
+            while (!map.put(k, 0, true))
+                std::this_thread::yield();
+        } });
+
+    std::map<int, int> last;
+    bool revived = false;
+    size_t retired = 0;
+    while (retired < KEYS)
+    {
+        const size_t n = map.drain([&](int k, int v)
+                                   {
+            auto [it, fresh] = last.try_emplace(k, v);
+            revived |= !fresh && it->second == 0 && v != 0; // a stale value after the retirement
+            retired += v == 0 && (fresh || it->second != 0);
+            it->second = v; });
+        if (!n)
+            std::this_thread::yield();
+    }
+    producer.join();
+
+    EXPECT_FALSE(revived);
+    EXPECT_EQ(last.size(), size_t{KEYS});
+}
+
+TEST(ConflatingMapTest, ConcurrentConsumerConvergesToFinalValues)
+{
+    constexpr int KEYS = 16;
+    constexpr int ROUNDS = 20000;
+    ConflatingMap<int, int> map(KEYS);
+
+    std::thread producer([&]
+                         {
+        for (int r = 1; r <= ROUNDS; ++r)
+            for (int k = 0; k < KEYS; ++k)
+                map.put(k, r); });
+
+    std::map<int, int> latest;
+    bool regressed = false;
+    auto consume = [&](int k, int v)
+    {
+        regressed |= v < latest[k]; // values only move forward
+        latest[k] = v;
+    };
+    for (bool done = false; !done;)
+    {
+        if (!map.drain(consume))
+            std::this_thread::yield();
+        done = latest.size() == KEYS;
+        for (auto &[k, v] : latest)
+            done &= v == ROUNDS;
+    }
+    producer.join();
+
+    EXPECT_FALSE(regressed);
+    for (int k = 0; k < KEYS; ++k)
+        EXPECT_EQ(latest[k], ROUNDS);
+}
@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+
+#include "utils/data_structures/MulticastRing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(MulticastRingTest, EveryConsumerSeesEveryItem)
+{
+    MulticastRing<int> ring(8);
+    auto *a = ring.subscribe(true);
+    auto *b = ring.subscribe(false);
+
+    const int items[] = {1, 2, 3};
+    ring.write(items, 3);
+
+    std::vector<int> seen_a, seen_b;
+    EXPECT_EQ(ring.poll(*a, [&](int v)
+                        { seen_a.push_back(v); }),
+              3);
+    EXPECT_EQ(ring.poll(*b, [&](int v)
+                        { seen_b.push_back(v); }),
+              3);
+    EXPECT_EQ(seen_a, (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(seen_b, seen_a);
+    EXPECT_TRUE(ring.empty(*a));
+}
+
+TEST(MulticastRingTest, ConsumerStartsAtCurrentHead)
+{
+    MulticastRing<int> ring(8);
+    const int first = 1;
+    ring.write(&first, 1);
+
+    auto *late = ring.subscribe(true);
+    EXPECT_TRUE(ring.empty(*late));
+}
+
+TEST(MulticastRingTest, GatingConsumerIsNeverOverrun)
+{
+    MulticastRing<int> ring(4);
+    auto *c = ring.subscribe(true);
+
+    const int items[] = {1, 2, 3, 4};
+    ASSERT_EQ(ring.free_slots(), 4);
+    ring.write(items, 4);
+    EXPECT_EQ(ring.free_slots(), 0);
+
+    EXPECT_EQ(ring.poll(*c, [](int) {}, 2), 2);
+    EXPECT_EQ(ring.free_slots(), 2);
+}
+
+TEST(MulticastRingTest, UnsubscribedConsumerStopsGating)
+{
+    MulticastRing<int> ring(4);
+    auto *c = ring.subscribe(true);
+    const int items[] = {1, 2, 3, 4};
+    ring.write(items, 4);
+    EXPECT_EQ(ring.free_slots(), 0);
+
+    ring.unsubscribe(c);
+    EXPECT_EQ(ring.free_slots(), 4);
+}
+
+TEST(MulticastRingTest, UnsubscribedSlotsAreReused)
+{
+    MulticastRing<int> ring(4);
+    for (size_t i = 0; i < 4 * MulticastRing<int>::MAX_CURSORS; ++i)
+    {
+        auto *c = ring.subscribe(i % 2 == 0);
+        const int v = static_cast<int>(i);
+        ASSERT_GT(ring.free_slots(), 0);
+        ring.write(&v, 1);
+        EXPECT_EQ(ring.poll(*c, [&](int x)
+                            { EXPECT_EQ(x, v); }),
+                  1u);
+        ring.unsubscribe(c);
+    }
+}
+
+TEST(MulticastRingTest, LappedNonGatingConsumerSkipsAhead)
+{
+    MulticastRing<int> ring(4);
+    auto *c = ring.subscribe(false);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_GT(ring.free_slots(), 0); // nothing gates
+        ring.write(&i, 1);
+    }
+
+    std::vector<int> seen;
+    ring.poll(*c, [&](int v)
+              { seen.push_back(v); });
+    EXPECT_EQ(seen, (std::vector<int>{6, 7, 8, 9})); // last full ring
+    EXPECT_EQ(c->dropped.load(), 6);
+}
+
+TEST(MulticastRingTest, ConcurrentGatingConsumersReceiveInOrder)
+{
+    constexpr int N = 20000;
+    MulticastRing<int> ring(64);
+    auto *a = ring.subscribe(true);
+    auto *b = ring.subscribe(true);
+
+    auto consume = [&](MulticastRing<int>::Cursor *c, bool &in_order)
+    {
+        int expected = 0;
+        in_order = true;
+        while (expected < N)
+            if (ring.poll(*c, [&](int v)
+                          { in_order &= (v == expected++); }) == 0)
+                std::this_thread::yield();
+    };
+    bool ok_a = false, ok_b = false;
+    std::thread ta(consume, a, std::ref(ok_a));
+    std::thread tb(consume, b, std::ref(ok_b));
+
+    for (int i = 0; i < N;)
+    {
+        if (ring.free_slots() == 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        ring.write(&i, 1);
+        ++i;
+    }
+    ta.join();
+    tb.join();
+
+    EXPECT_TRUE(ok_a);
+    EXPECT_TRUE(ok_b);
+}
+
+TEST(MulticastRingTest, SubscribeAndUnsubscribeWhilePublishing)
+{
+    MulticastRing<int> ring(64);
+    std::atomic<bool> stop{false};
+    std::thread producer([&]
+                         {
+        for (int i = 0; !stop.load(std::memory_order_relaxed);)
+        {
+            const size_t free = ring.free_slots();
+            if (free == 0)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            int batch[8];
+            const size_t n = std::min<size_t>(free, 8);
+            for (size_t k = 0; k < n; ++k)
+                batch[k] = i++;
+            ring.write(batch, n);
+        } });
+
+    // Gating cursors come and go under a running producer: each one sees an
+    // unbroken run from wherever it joined
+    bool in_order = true;
+    for (int round = 0; round < 500; ++round)
+    {
+        auto *c = ring.subscribe(true);
+        int expected = -1;
+        for (int got = 0; got < 200;)
+        {
+            const size_t n = ring.poll(*c, [&](int v)
+                                       {
+                in_order &= expected < 0 || v == expected;
+                expected = v + 1; });
+            if (n == 0)
+                std::this_thread::yield();
+            got += static_cast<int>(n);
+        }
+        ring.unsubscribe(c);
+    }
+    stop = true;
+    producer.join();
+
+    EXPECT_TRUE(in_order);
+}
+
+TEST(MulticastRingTest, PollBatchGivesGatingConsumersContiguousRuns)
+{
+    MulticastRing<int> ring(8);
+    auto *c = ring.subscribe(true);
+
+    const int first[] = {1, 2, 3, 4, 5, 6};
+    ring.write(first, 6);
+    EXPECT_EQ(ring.poll_batch(*c, [](std::span<const int>) {}), 6u);
+
+    // next 5 items wrap: slots 6,7 then 0,1,2
+    const int second[] = {7, 8, 9, 10, 11};
+    ring.write(second, 5);
+    std::vector<std::vector<int>> runs;
+    EXPECT_EQ(ring.poll_batch(*c, [&](std::span<const int> run)
+                              { runs.emplace_back(run.begin(), run.end()); }),
+              5u);
+    ASSERT_EQ(runs.size(), 2u);
+    EXPECT_EQ(runs[0], (std::vector<int>{7, 8}));
+    EXPECT_EQ(runs[1], (std::vector<int>{9, 10, 11}));
+    EXPECT_TRUE(ring.empty(*c));
+}
+
+TEST(MulticastRingTest, PollBatchOnLappedNonGatingConsumerSkipsAhead)
+{
+    MulticastRing<int> ring(4);
+    auto *c = ring.subscribe(false);
+
+    const int items[] = {1, 2, 3, 4, 5, 6};
+    ring.write(items, 6); // 1 and 2 overwritten
+
+    std::vector<int> seen;
+    EXPECT_EQ(ring.poll_batch(*c, [&](std::span<const int> run)
+                              { seen.insert(seen.end(), run.begin(), run.end()); }),
+              4u);
+    EXPECT_EQ(seen, (std::vector<int>{3, 4, 5, 6}));
+    EXPECT_EQ(c->dropped.load(), 2u);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include "utils/data_structures/OccupancyBitmap.h"
+
+#include <random>
+#include <set>
+
+TEST(OccupancyBitmapTest, EmptyBitmapFindsNothing)
+{
+    OccupancyBitmap bits(1000);
+    EXPECT_FALSE(bits.any());
+    EXPECT_EQ(bits.first(), OccupancyBitmap::NPOS);
+    EXPECT_EQ(bits.last(), OccupancyBitmap::NPOS);
+    EXPECT_EQ(bits.find_next(10), OccupancyBitmap::NPOS);
+    EXPECT_EQ(bits.find_prev(10), OccupancyBitmap::NPOS);
+}
+
+TEST(OccupancyBitmapTest, SetClearAndTest)
+{
+    OccupancyBitmap bits(200);
+    bits.set(0);
+    bits.set(63);
+    bits.set(64);
+    bits.set(199);
+
+    EXPECT_TRUE(bits.test(63));
+    EXPECT_TRUE(bits.test(64));
+    EXPECT_FALSE(bits.test(65));
+    EXPECT_EQ(bits.first(), 0);
+    EXPECT_EQ(bits.last(), 199);
+
+    bits.clear(0);
+    bits.clear(199);
+    EXPECT_EQ(bits.first(), 63);
+    EXPECT_EQ(bits.last(), 64);
+}
+
+TEST(OccupancyBitmapTest, FindAcrossWordsAndLevels)
+{
+    // 3 levels: 100000 bits -> 1563 leaf words -> 25 -> 1
+    OccupancyBitmap bits(100000);
+    bits.set(5);
+    bits.set(70000);
+    bits.set(99999);
+
+    EXPECT_EQ(bits.find_next(6), 70000);
+    EXPECT_EQ(bits.find_next(70000), 70000);
+    EXPECT_EQ(bits.find_next(70001), 99999);
+    EXPECT_EQ(bits.find_prev(69999), 5);
+    EXPECT_EQ(bits.find_prev(99998), 70000);
+    EXPECT_EQ(bits.find_prev(4), OccupancyBitmap::NPOS);
+
+    bits.clear(70000);
+    EXPECT_EQ(bits.find_next(6), 99999);
+    EXPECT_EQ(bits.find_prev(99998), 5);
+}
+
+TEST(OccupancyBitmapTest, MatchesReferenceSet)
+{
+    constexpr size_t N = 5000;
+    OccupancyBitmap bits(N);
+    std::set<size_t> ref;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<size_t> pick(0, N - 1);
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        const size_t k = pick(rng);
+        if (rng() & 1)
+        {
+            bits.set(k);
+            ref.insert(k);
+        }
+        else
+        {
+            bits.clear(k);
+            ref.erase(k);
+        }
+
+        const size_t q = pick(rng);
+        auto next = ref.lower_bound(q);
+        EXPECT_EQ(bits.find_next(q), next == ref.end() ? OccupancyBitmap::NPOS : *next);
+        auto prev = ref.upper_bound(q);
+        EXPECT_EQ(bits.find_prev(q), prev == ref.begin() ? OccupancyBitmap::NPOS : *std::prev(prev));
+    }
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include "utils/data_structures/spsc.h"
+
+#include <thread>
+#include <vector>
+
+TEST(SPSCTest, IndicesLiveOnSeparateCacheLines)
+{
+    EXPECT_EQ(alignof(SPSC<int>), 64);
+    EXPECT_EQ(sizeof(SPSC<int>) % 64, 0);
+}
+
+TEST(SPSCTest, PushPopUntilFull)
+{
+    SPSC<int> q(4);
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE(q.push(i));
+    EXPECT_FALSE(q.push(4)); // full
+
+    int v = -1;
+    EXPECT_TRUE(q.pop(v));
+    EXPECT_EQ(v, 0);
+    EXPECT_TRUE(q.push(4)); // tail refreshed once the ring looked full
+}
+
+TEST(SPSCTest, PushNStopsAtCapacity)
+{
+    SPSC<int> q(4);
+    const int items[] = {1, 2, 3, 4, 5, 6};
+    EXPECT_EQ(q.push_n(items, 6), 4);
+    EXPECT_EQ(q.push_n(items, 1), 0);
+
+    int out[8];
+    EXPECT_EQ(q.pop_n(out, 8), 4);
+    EXPECT_EQ(out[3], 4);
+    EXPECT_EQ(q.pop_n(out, 8), 0);
+}
+
+TEST(SPSCTest, PopNTakesAtMostMax)
+{
+    SPSC<int> q(8);
+    const int items[] = {1, 2, 3, 4, 5};
+    q.push_n(items, 5);
+
+    int out[2];
+    EXPECT_EQ(q.pop_n(out, 2), 2);
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[1], 2);
+    EXPECT_EQ(q.snapshot().size(), 3);
+}
+
+TEST(SPSCTest, ConcurrentBatchesArriveInOrder)
+{
+    constexpr int N = 50000;
+    SPSC<int> q(64);
+
+    std::thread producer([&]
+                         {
+        int next = 0;
+        int batch[16];
+        while (next < N)
+        {
+            int n = 0;
+            while (n < 16 && next + n < N)
+            {
+                batch[n] = next + n;
+                ++n;
+            }
+            next += static_cast<int>(q.push_n(batch, n));
+            std::this_thread::yield();
+        } });
+
+    int expected = 0;
+    bool in_order = true;
+    int out[16];
+    while (expected < N)
+    {
+        const size_t n = q.pop_n(out, 16);
+        for (size_t i = 0; i < n; ++i)
+            in_order &= (out[i] == expected++);
+        if (n == 0)
+            std::this_thread::yield();
+    }
+    producer.join();
+    EXPECT_TRUE(in_order);
+}
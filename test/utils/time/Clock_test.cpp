@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include "utils/time/ManualClock.h"
+#include "utils/time/MonotonicClock.h"
+#include "utils/time/TscClock.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+TEST(ClockTest, ManualClockOnlyMovesWhenTold)
+{
+    ManualClock clock(100);
+    EXPECT_EQ(clock.now(), 100u);
+    EXPECT_EQ(clock.now(), 100u);
+    clock.advance(50);
+    EXPECT_EQ(clock.now(), 150u);
+    clock.set(7);
+    EXPECT_EQ(clock.now(), 7u);
+}
+
+TEST(ClockTest, TscClockIsMonotonic)
+{
+    TscClock clock(2ms);
+    Timestamp prev = clock.now();
+    for (int i = 0; i < 100000; ++i)
+    {
+        const Timestamp t = clock.now();
+        ASSERT_GE(t, prev);
+        prev = t;
+    }
+}
+
+TEST(ClockTest, TscClockTracksMonotonicClock)
+{
+    TscClock clock(5ms);
+    EXPECT_EQ(clock.uses_tsc(), TscClock::invariant_tsc() && clock.ticks_per_ns() > 0);
+
+    const Timestamp m0 = MonotonicClock::read();
+    const Timestamp t0 = clock.now();
+    std::this_thread::sleep_for(20ms);
+    const Timestamp t1 = clock.now();
+    const Timestamp m1 = MonotonicClock::read();
+
+    // same timebase, and elapsed time agrees to well under 1%
+    EXPECT_LT(t0 > m0 ? t0 - m0 : m0 - t0, 1'000'000u);
+    const double tsc_elapsed = static_cast<double>(t1 - t0);
+    const double ref_elapsed = static_cast<double>(m1 - m0);
+    EXPECT_NEAR(tsc_elapsed / ref_elapsed, 1.0, 0.01);
+}
+
+TEST(ClockTest, DefaultClockIsShared)
+{
+    EXPECT_EQ(&default_clock(), &default_clock());
+    const Timestamp a = default_clock().now();
+    EXPECT_GE(default_clock().now(), a);
+}